@@ -0,0 +1,58 @@
+#include "battle/BattleSimulation.h"
+#include "data/GameData.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Usage: battle_bench [data directory] [combatants per side]
+// Fills both sides of a fleet battle from the crew and the enemies in
+// characters.json, then times BattleSimulation::tick at 60 ticks per second
+// until one side is defeated.
+int main(int argc, char** argv) {
+    std::string dataDir = argc > 1 ? argv[1] : "assets/data";
+    std::size_t perSide = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+    const float deltaTime = 1.0f / 60.0f;
+    const int maxTicks = 60 * 60 * 10;
+    
+    GameData data;
+    if (!data.loadFromJson(dataDir) || data.characters.characters.empty() || data.characters.enemies.empty()) {
+        std::printf("Could not load characters from %s\n", dataDir.c_str());
+        return 1;
+    }
+    
+    BattleSimulation battle(1234);
+    for (std::size_t i = 0; i < perSide; ++i) {
+        const auto& crew = data.characters.characters[i % data.characters.characters.size()];
+        battle.addCombatant(crew.second, 0, 10);
+    }
+    for (std::size_t i = 0; i < perSide; ++i) {
+        const auto& enemy = data.characters.enemies[i % data.characters.enemies.size()];
+        battle.addCombatant(enemy.second, 1, 10);
+    }
+    
+    double totalUs = 0;
+    double worstUs = 0;
+    double fullUs = 0; // First second, while both fleets are at full strength
+    while (!battle.isOver() && battle.getTickCount() < static_cast<std::uint64_t>(maxTicks)) {
+        auto start = std::chrono::steady_clock::now();
+        battle.tick(deltaTime);
+        auto end = std::chrono::steady_clock::now();
+        
+        double us = std::chrono::duration<double, std::micro>(end - start).count();
+        totalUs += us;
+        worstUs = std::max(worstUs, us);
+        if (battle.getTickCount() <= 60) {
+            fullUs += us;
+        }
+    }
+    
+    std::uint64_t ticks = battle.getTickCount();
+    std::printf("%zu vs %zu, %llu ticks (%.1f s of battle), winner: team %d\n", perSide, perSide,
+                static_cast<unsigned long long>(ticks), ticks * deltaTime, battle.getWinner());
+    std::printf("first second  %8.2f us/tick\n", fullUs / std::min<std::uint64_t>(ticks, 60));
+    std::printf("whole battle  %8.2f us/tick, worst %.2f us\n", totalUs / ticks, worstUs);
+    std::printf("survivors: %zu / %zu\n", battle.getAliveCount(0), battle.getAliveCount(1));
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include "data/GameData.h"
+#include "data/GameDatabase.h"
+#include "data/JsonTape.h"
+#include "data/StructReader.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+// Usage: data_bench [data directory] [game.db]
+// Times reading the data files into the typed records (without the link pass):
+//   dom    nlohmann::json::parse, then extraction from the DOM
+//   sax    nlohmann::json::sax_parse straight into the records
+//   tape   JsonTape parse and replay (development builds)
+//   db     replay from the compiled database (release builds)
+// The DOM extraction feeds the same StructReader, so it is a lower bound on
+// hand-written j.at("field") code.
+namespace {
+    struct DataFile {
+        const char* file;
+        const char* root;
+    };
+    
+    const DataFile DATA_FILES[] = {
+        { "characters.json", "characters" },
+        { "items.json", "items" },
+        { "locations.json", "locations" },
+        { "dialogue/characters.json", "dialogue" }
+    };
+    
+    const int FILE_COUNT = sizeof(DATA_FILES) / sizeof(DATA_FILES[0]);
+    
+    std::string readFile(const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    }
+    
+    // Best time of several runs, in microseconds
+    template<class Function>
+    double bestOf(int runs, Function function) {
+        double best = 1e30;
+        for (int i = 0; i < runs; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        return best;
+    }
+    
+    // Emits the SAX events of an already parsed DOM
+    template<class Handler>
+    void walkDom(const nlohmann::json& value, Handler& handler, std::string& scratch) {
+        switch (value.type()) {
+            case nlohmann::json::value_t::object:
+                handler.start_object(value.size());
+                for (auto it = value.begin(); it != value.end(); ++it) {
+                    scratch = it.key();
+                    handler.key(scratch);
+                    walkDom(it.value(), handler, scratch);
+                }
+                handler.end_object();
+                break;
+            case nlohmann::json::value_t::array:
+                handler.start_array(value.size());
+                for (const auto& element : value) {
+                    walkDom(element, handler, scratch);
+                }
+                handler.end_array();
+                break;
+            case nlohmann::json::value_t::string:
+                scratch = value.get_ref<const std::string&>();
+                handler.string(scratch);
+                break;
+            case nlohmann::json::value_t::boolean:
+                handler.boolean(value.get<bool>());
+                break;
+            case nlohmann::json::value_t::number_integer:
+            case nlohmann::json::value_t::number_unsigned:
+                handler.number_integer(value.get<std::int64_t>());
+                break;
+            case nlohmann::json::value_t::number_float:
+                handler.number_float(value.get<double>(), scratch);
+                break;
+            default:
+                handler.null();
+                break;
+        }
+    }
+    
+    void* recordOf(GameData& data, const char* root, const TypeInfo*& type) {
+        if (root[0] == 'c') {
+            type = &typeOf<CharacterFile>();
+            return &data.characters;
+        }
+        if (root[0] == 'i') {
+            type = &typeOf<ItemFile>();
+            return &data.items;
+        }
+        if (root[0] == 'l') {
+            type = &typeOf<LocationFile>();
+            return &data.locations;
+        }
+        type = &typeOf<DialogueFile>();
+        return &data.dialogue;
+    }
+    
+    // Order-independent summary used to check that every path loaded the same records
+    long long checksum(const GameData& data) {
+        long long sum = 0;
+        for (const auto& character : data.characters.characters) {
+            for (int stat : character.second.baseStats) {
+                sum += stat;
+            }
+            sum += character.second.devilFruit ? character.second.devilFruit->abilities.size() * 1000 : 0;
+        }
+        for (const auto& enemy : data.characters.enemies) {
+            sum += enemy.second.bounty % 100000 + (enemy.second.dropTable ? enemy.second.dropTable->berry[1] : 0);
+        }
+        for (const auto& category : data.items.items) {
+            for (const auto& item : category.second) {
+                sum += item.second.value + item.second.statBonuses.size() + item.second.effects.heal;
+            }
+        }
+        for (const auto& set : data.items.itemSets) {
+            for (const auto& bonus : set.second.setBonuses) {
+                sum += bonus.second.stats.size() * 7 + bonus.second.specialAbility.size();
+            }
+        }
+        for (const auto& location : data.locations.locations) {
+            sum += location.second.npcs.size() * 3 + location.second.connectedLocations.size();
+            for (const auto& encounter : location.second.randomEncounters) {
+                sum += static_cast<long long>(encounter.encounterRate * 1000) + encounter.enemyGroups.size();
+            }
+        }
+        for (const auto& speaker : data.dialogue.dialogues) {
+            for (const auto& node : speaker.second) {
+                for (const DialogueLine& line : node.second) {
+                    sum += line.responses.size() * 11 + line.conditions.size() + line.amount;
+                }
+            }
+        }
+        return sum + data.locations.regions.size() + static_cast<long long>(data.getStringBytes());
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string dataDir = argc > 1 ? argv[1] : "assets/data";
+    std::string databasePath = argc > 2 ? argv[2] : "";
+    const int runs = 200;
+    
+    std::string sources[FILE_COUNT];
+    for (int i = 0; i < FILE_COUNT; ++i) {
+        sources[i] = readFile(dataDir + "/" + DATA_FILES[i].file);
+        if (sources[i].empty()) {
+            std::printf("Could not read %s/%s\n", dataDir.c_str(), DATA_FILES[i].file);
+            return 1;
+        }
+    }
+    
+    GameData data;
+    long long expected = 0;
+    
+    double domUs = bestOf(runs, [&]() {
+        data.clear();
+        for (int i = 0; i < FILE_COUNT; ++i) {
+            nlohmann::json document = nlohmann::json::parse(sources[i]);
+            const TypeInfo* type;
+            void* record = recordOf(data, DATA_FILES[i].root, type);
+            StructReader reader(record, *type, data.getReadContext());
+            std::string scratch;
+            walkDom(document, reader, scratch);
+        }
+    });
+    expected = checksum(data);
+    std::printf("dom  + extract  %9.1f us\n", domUs);
+    
+    bool saxOk = true;
+    double saxUs = bestOf(runs, [&]() {
+        data.clear();
+        for (int i = 0; i < FILE_COUNT; ++i) {
+            const TypeInfo* type;
+            void* record = recordOf(data, DATA_FILES[i].root, type);
+            StructReader reader(record, *type, data.getReadContext());
+            saxOk = nlohmann::json::sax_parse(sources[i], &reader) && saxOk;
+        }
+    });
+    std::printf("sax  -> records %9.1f us  %5.2fx  %s\n", saxUs, domUs / saxUs,
+                saxOk && checksum(data) == expected ? "ok" : "MISMATCH");
+    
+    bool tapeOk = true;
+    JsonTape tape;
+    double tapeUs = bestOf(runs, [&]() {
+        data.clear();
+        for (int i = 0; i < FILE_COUNT; ++i) {
+            const TypeInfo* type;
+            void* record = recordOf(data, DATA_FILES[i].root, type);
+            StructReader reader(record, *type, data.getReadContext());
+            tapeOk = tape.parse(sources[i]) && tape.replay(reader) && tapeOk;
+        }
+    });
+    std::printf("tape -> records %9.1f us  %5.2fx  %s\n", tapeUs, domUs / tapeUs,
+                tapeOk && checksum(data) == expected ? "ok" : "MISMATCH");
+    
+    if (!databasePath.empty()) {
+        GameDatabase database;
+        if (!database.open(databasePath)) {
+            std::printf("Could not open %s\n", databasePath.c_str());
+            return 1;
+        }
+        
+        bool dbOk = true;
+        double dbUs = bestOf(runs, [&]() {
+            data.clear();
+            for (int i = 0; i < FILE_COUNT; ++i) {
+                const TypeInfo* type;
+                void* record = recordOf(data, DATA_FILES[i].root, type);
+                StructReader reader(record, *type, data.getReadContext());
+                dbOk = database.root(DATA_FILES[i].root).replay(reader) && dbOk;
+            }
+        });
+        std::printf("db   -> records %9.1f us  %5.2fx  %s\n", dbUs, domUs / dbUs,
+                    dbOk && checksum(data) == expected ? "ok" : "MISMATCH");
+    }
+    
+    std::printf("strings: %zu bytes in the arena\n", data.getStringBytes());
+    return 0;
+}
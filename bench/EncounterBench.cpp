@@ -0,0 +1,133 @@
+#include "game/EncounterTables.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Usage: encounter_bench [groups] [steps]
+// Walks one location with that many weighted enemy groups and a combined
+// encounter rate of 0.1 per step, two ways:
+//   scan       roll the rate every step, then a cumulative-weight scan
+//   countdown  EncounterCountdown over EncounterTables
+// and checks that both meet each group as often as its weight says.
+namespace {
+    struct Result {
+        double ms = 0;
+        std::size_t encounters = 0;
+        std::vector<std::size_t> met; // By the StringId index of the group's enemy
+    };
+    
+    std::size_t enemyIndex(const EnemyGroup& group) {
+        return group[0].id.index;
+    }
+    
+    std::size_t idLimit(const Location& location) {
+        std::size_t limit = 0;
+        for (const RandomEncounter& encounter : location.randomEncounters) {
+            limit = std::max(limit, enemyIndex(encounter.enemyGroups[0]) + 1);
+        }
+        return limit;
+    }
+    
+    Result runScan(const Location& location, std::uint64_t steps) {
+        Result result;
+        result.met.resize(idLimit(location), 0);
+        float totalRate = 0;
+        for (const RandomEncounter& encounter : location.randomEncounters) {
+            totalRate += encounter.encounterRate;
+        }
+        
+        Random random(99);
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t step = 0; step < steps; ++step) {
+            if (random.nextFloat() >= totalRate) {
+                continue;
+            }
+            float roll = random.nextFloat() * totalRate;
+            std::size_t picked = location.randomEncounters.size() - 1;
+            for (std::size_t i = 0; i < location.randomEncounters.size(); ++i) {
+                roll -= location.randomEncounters[i].encounterRate;
+                if (roll < 0) {
+                    picked = i;
+                    break;
+                }
+            }
+            ++result.encounters;
+            ++result.met[enemyIndex(location.randomEncounters[picked].enemyGroups[0])];
+        }
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    
+    Result runCountdown(const LocationFile& locations, StringId id, std::uint64_t steps) {
+        const Location& location = locations.locations[0].second;
+        Result result;
+        result.met.resize(idLimit(location), 0);
+        EncounterTables tables(locations);
+        EncounterCountdown countdown(tables);
+        
+        Random random(99);
+        countdown.enter(id, random);
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t step = 0; step < steps; ++step) {
+            const EnemyGroup* group = countdown.step(random);
+            if (group) {
+                ++result.encounters;
+                ++result.met[enemyIndex(*group)];
+            }
+        }
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    
+    // Largest gap between a group's share of encounters and its weight,
+    // in standard deviations
+    double worstDeviation(const Location& location, const Result& result) {
+        double worst = 0;
+        for (const RandomEncounter& encounter : location.randomEncounters) {
+            double expected = result.encounters * encounter.encounterRate / 0.1;
+            double met = static_cast<double>(result.met[enemyIndex(encounter.enemyGroups[0])]);
+            worst = std::max(worst, std::fabs(met - expected) / std::sqrt(expected));
+        }
+        return worst;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t groupCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 48;
+    std::uint64_t steps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50000000;
+    if (groupCount == 0) {
+        std::printf("Need at least one group\n");
+        return 1;
+    }
+    
+    // Weights 1 to 8, scaled to a total rate of 0.1
+    StringInterner& ids = StringInterner::instance();
+    LocationFile locations;
+    StringId id = ids.intern("bench_location");
+    Location& location = locations.locations.emplace_back(id, Location()).second;
+    Random random(7);
+    float totalWeight = 0;
+    for (std::size_t i = 0; i < groupCount; ++i) {
+        RandomEncounter encounter;
+        encounter.enemyGroups.emplace_back(1, Ref<Character>{ ids.intern("bench_enemy_" + std::to_string(i)) });
+        encounter.encounterRate = static_cast<float>(1 + random.nextBelow(8));
+        totalWeight += encounter.encounterRate;
+        location.randomEncounters.push_back(encounter);
+    }
+    for (RandomEncounter& encounter : location.randomEncounters) {
+        encounter.encounterRate *= 0.1f / totalWeight;
+    }
+    
+    std::printf("%zu groups, %llu steps\n", groupCount, static_cast<unsigned long long>(steps));
+    const char* names[] = { "scan", "countdown" };
+    Result results[] = { runScan(location, steps), runCountdown(locations, id, steps) };
+    for (int i = 0; i < 2; ++i) {
+        std::printf("%-10s %8.1f ms %6.2f ns/step  %zu encounters  worst group %.1f sigma\n", names[i],
+                    results[i].ms, results[i].ms * 1e6 / steps, results[i].encounters,
+                    worstDeviation(location, results[i]));
+    }
+    return 0;
+}
@@ -0,0 +1,242 @@
+#include "data/JsonTape.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Usage: json_bench [data directory] [synthetic megabytes]
+// Times nlohmann::json::parse against JsonTape (every backend the CPU
+// supports) on the files in assets/data and on a synthetic document built
+// by repeating them. Also replays each tape into a nlohmann DOM and checks
+// that it matches nlohmann's own result, and first checks that every
+// backend accepts and rejects the same edge cases as nlohmann.
+namespace {
+    const char* DATA_FILES[] = {
+        "characters.json",
+        "items.json",
+        "locations.json",
+        "dialogue/characters.json"
+    };
+    
+    const JsonTape::Backend BACKENDS[] = {
+        JsonTape::Backend::Scalar,
+        JsonTape::Backend::SSE2,
+        JsonTape::Backend::AVX2
+    };
+    
+    // Strings whose bytes decide acceptance, mostly UTF-8 edge cases. Each
+    // is also tried at every offset across a 64-byte block boundary.
+    const char* const STRING_CASES[] = {
+        "plain",
+        "caf\xC3\xA9",                 // 2-byte
+        "\xE2\x82\xAC",               // 3-byte
+        "\xF0\x9F\x98\x80",           // 4-byte
+        "\xEF\xBF\xBF\xF4\x8F\xBF\xBF", // U+FFFF, U+10FFFF
+        "\xFF",
+        "\xFE",
+        "\x80",                         // Stray continuation
+        "\xC3\xA9\xA9",               // Continuation after a complete sequence
+        "\xC3",                         // Truncated 2-byte
+        "\xE2\x82",                    // Truncated 3-byte
+        "\xF0\x9F\x98",               // Truncated 4-byte
+        "\xC3x",                        // Lead followed by ASCII
+        "\xC0\x80",                    // Overlong NUL
+        "\xC1\xBF",                    // Overlong 2-byte
+        "\xE0\x9F\xBF",               // Overlong 3-byte
+        "\xF0\x8F\xBF\xBF",           // Overlong 4-byte
+        "\xED\xA0\x80",               // Surrogate
+        "\xED\x9F\xBF",               // Last code point before the surrogates
+        "\xF4\x90\x80\x80",           // Past U+10FFFF
+        "\xF5\x80\x80\x80",
+        "\xF8\x88\x80\x80\x80",       // 5-byte form
+        "\xE2\x82\xAC\xE2\x82",       // Valid then truncated
+        "\\u00e9\xC3\xA9",           // Escape next to raw UTF-8
+        "\\ud83d\\ude00",
+        "\\ud83d",                     // Lone high surrogate escape
+        "tab\tinside"
+    };
+    
+    // Whole documents, including bytes outside strings
+    const char* const DOCUMENT_CASES[] = {
+        "[\"\xFF\"]",
+        "{\"\xC3\xA9\":1}",
+        "{\"\xC3\":1}",
+        "[1,\xC3\xA9]",
+        "\xEF\xBB\xBF[]",             // Byte order mark
+        "[] \xC3",
+        "\"\xF0\x9F\x98\x80\"",
+        "[1e400]",
+        "[-9223372036854775808, 18446744073709551616]",
+        "[01]",
+        "[\"\\x\"]"
+    };
+    
+    std::string readFile(const std::string& path) {
+        std::ifstream input(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    }
+    
+    // Best time of several runs, in milliseconds
+    template<class Function>
+    double bestOf(int runs, Function function) {
+        double best = 1e30;
+        for (int i = 0; i < runs; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return best;
+    }
+    
+    double throughput(std::size_t bytes, double ms) {
+        return bytes / (ms / 1000.0) / (1024.0 * 1024.0);
+    }
+    
+    bool matchesNlohmann(const JsonTape& tape, const nlohmann::json& expected) {
+        nlohmann::json rebuilt;
+        nlohmann::detail::json_sax_dom_parser<nlohmann::json> builder(rebuilt);
+        return tape.replay(builder) && rebuilt == expected;
+    }
+    
+    // nlohmann has no nesting limit, so apply the tape's 64 levels here
+    bool nlohmannAccepts(const std::string& json) {
+        if (!nlohmann::json::accept(json)) {
+            return false;
+        }
+        int depth = 0;
+        bool inString = false;
+        for (std::size_t i = 0; i < json.size(); ++i) {
+            char c = json[i];
+            if (inString) {
+                if (c == '\\') {
+                    ++i;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '[' || c == '{') {
+                if (++depth > 64) {
+                    return false;
+                }
+            } else if (c == ']' || c == '}') {
+                --depth;
+            }
+        }
+        return true;
+    }
+    
+    // Returns the number of inputs where some backend disagrees with nlohmann
+    int checkConformance() {
+        std::vector<std::string> inputs;
+        for (const char* text : STRING_CASES) {
+            for (std::size_t pad = 0; pad <= 70; ++pad) {
+                inputs.push_back("[\"" + std::string(pad, 'a') + text + "\"]");
+            }
+        }
+        for (const char* text : DOCUMENT_CASES) {
+            inputs.push_back(text);
+            // Ending exactly on a block boundary takes a different path
+            // from the padded final block
+            std::string spaced = std::string(64 - std::string(text).size() % 64, ' ') + text;
+            inputs.push_back(spaced);
+        }
+        for (std::size_t depth : { 64, 65, 1000000 }) {
+            inputs.push_back(std::string(depth, '[') + std::string(depth, ']'));
+        }
+        
+        int mismatches = 0;
+        for (const std::string& json : inputs) {
+            bool expected = nlohmannAccepts(json);
+            for (JsonTape::Backend backend : BACKENDS) {
+                if (!JsonTape::isSupported(backend)) {
+                    continue;
+                }
+                JsonTape tape(backend);
+                if (tape.parse(json) != expected) {
+                    if (mismatches < 10) {
+                        std::printf("conformance %-6s %s, nlohmann %s:", JsonTape::backendName(backend),
+                                    expected ? "rejects" : "accepts", expected ? "accepts" : "rejects");
+                        for (unsigned char c : json.substr(0, 80)) {
+                            std::printf(c >= 0x20 && c < 0x7F ? "%c" : "\\x%02X", c);
+                        }
+                        std::printf("\n");
+                    }
+                    ++mismatches;
+                }
+            }
+        }
+        std::printf("conformance: %zu inputs, %d mismatches\n", inputs.size(), mismatches);
+        return mismatches;
+    }
+    
+    void benchmark(const char* name, const std::string& json, int runs) {
+        nlohmann::json expected = nlohmann::json::parse(json);
+        double nlohmannMs = bestOf(runs, [&]() {
+            nlohmann::json document = nlohmann::json::parse(json);
+        });
+        std::printf("%-26s %9zu bytes  nlohmann %8.3f ms %8.1f MB/s\n", name, json.size(), nlohmannMs, throughput(json.size(), nlohmannMs));
+        
+        for (JsonTape::Backend backend : BACKENDS) {
+            if (!JsonTape::isSupported(backend)) {
+                continue;
+            }
+            
+            JsonTape tape(backend);
+            double tapeMs = bestOf(runs, [&]() {
+                tape.parse(json);
+            });
+            if (!tape.parse(json)) {
+                std::printf("%-26s %-6s error: %s\n", "", JsonTape::backendName(backend), tape.getError().c_str());
+                continue;
+            }
+            
+            bool matches = matchesNlohmann(tape, expected);
+            std::printf("%-26s %-6s  tape     %8.3f ms %8.1f MB/s  %5.1fx  %s\n", "", JsonTape::backendName(backend),
+                        tapeMs, throughput(json.size(), tapeMs), nlohmannMs / tapeMs, matches ? "ok" : "MISMATCH");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string dataDir = argc > 1 ? argv[1] : "assets/data";
+    std::size_t syntheticMb = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 100;
+    
+    if (checkConformance() != 0) {
+        return 1;
+    }
+    
+    std::vector<std::string> files;
+    for (const char* file : DATA_FILES) {
+        std::string json = readFile(dataDir + "/" + file);
+        if (json.empty()) {
+            std::printf("Could not read %s/%s\n", dataDir.c_str(), file);
+            return 1;
+        }
+        benchmark(file, json, 200);
+        files.push_back(json);
+    }
+    
+    // Synthetic input: an array repeating every data file until it reaches the target size
+    std::string synthetic = "[";
+    std::size_t target = syntheticMb * 1024 * 1024;
+    while (synthetic.size() < target) {
+        for (const std::string& json : files) {
+            if (synthetic.size() > 1) {
+                synthetic += ',';
+            }
+            synthetic += json;
+        }
+    }
+    synthetic += ']';
+    
+    std::string label = "synthetic " + std::to_string(syntheticMb) + " MB";
+    benchmark(label.c_str(), synthetic, 3);
+    return 0;
+}
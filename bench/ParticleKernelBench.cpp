@@ -0,0 +1,87 @@
+#include "particles/ParticleKernel.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+// Usage: particle_bench [particles] [frames]
+// Times ParticleKernel::update for every backend the CPU supports. Every
+// backend starts from the same particles, so their checksums must agree
+// (within float rounding) with the first one's.
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 200;
+    
+    ParticleUpdateParams params;
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> xDist(params.minX, params.maxX);
+    std::uniform_real_distribution<float> yDist(params.minY, params.maxY);
+    std::uniform_real_distribution<float> sizeDist(1, 4);
+    
+    ParticleArrays initial;
+    initial.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        initial.x[i] = xDist(gen);
+        initial.y[i] = yDist(gen);
+        initial.vx[i] = 0;
+        initial.vy[i] = -20;
+        initial.radius[i] = sizeDist(gen);
+        initial.phase[i] = initial.x[i] * params.phaseScale;
+    }
+    
+    const ParticleKernel::Backend backends[] = {
+        ParticleKernel::Backend::Scalar,
+        ParticleKernel::Backend::SSE,
+        ParticleKernel::Backend::AVX
+    };
+    
+    std::printf("%zu particles, %d frames\n", count, frames);
+    bool haveReference = false;
+    double reference = 0;
+    bool allMatch = true;
+    for (ParticleKernel::Backend backend : backends) {
+        if (!ParticleKernel::isSupported(backend)) {
+            std::printf("%-8s unsupported\n", ParticleKernel::backendName(backend));
+            continue;
+        }
+        
+        ParticleArrays particles = initial;
+        
+        ParticleKernel kernel(backend);
+        float time = 0;
+        const float deltaTime = 1.0f / 60.0f;
+        
+        // Warm up caches and page in the arrays
+        kernel.update(particles, params, deltaTime, time);
+        
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            time += deltaTime;
+            kernel.update(particles, params, deltaTime, time);
+        }
+        auto end = std::chrono::steady_clock::now();
+        
+        double totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+        double msPerFrame = totalMs / frames;
+        double nsPerParticle = msPerFrame * 1e6 / static_cast<double>(count);
+        
+        // Checksum keeps the optimiser from discarding the work
+        double checksum = 0;
+        for (std::size_t i = 0; i < count; i += 997) {
+            checksum += particles.alpha[i] + particles.y[i];
+        }
+        if (!haveReference) {
+            reference = checksum;
+            haveReference = true;
+        }
+        bool matches = std::fabs(checksum - reference) <= 1e-4 * std::fabs(reference) + 1e-3;
+        allMatch = allMatch && matches;
+        
+        std::printf("%-8s %8.3f ms/frame %7.3f ns/particle (checksum %.1f) %s\n",
+                    ParticleKernel::backendName(backend), msPerFrame, nsPerParticle, checksum,
+                    matches ? "ok" : "MISMATCH");
+    }
+    
+    return allMatch ? 0 : 1;
+}
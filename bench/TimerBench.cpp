@@ -0,0 +1,169 @@
+#include "game/TimingWheel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Usage: timer_bench [timers] [ticks]
+// Keeps a fixed number of timers running at 60 ticks per second: ability
+// cooldowns of 2 to 120 s and, for one timer in ten, 300 s buffs. Expired
+// timers restart with a new delay and 0.1% of the timers are refreshed
+// (cancelled and restarted) every tick. Each timer's delays depend only on
+// its id, so every implementation sees the same expiries:
+//   scan   every timer counts down every tick
+//   heap   binary heap of expiry ticks, cancels skipped lazily on pop
+//   wheel  TimingWheel
+namespace {
+    std::uint64_t mix(std::uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+    
+    // Delay of the timer's restart number count, in ticks
+    std::uint32_t delayFor(std::uint32_t id, std::uint32_t count) {
+        std::uint64_t random = mix((static_cast<std::uint64_t>(id) << 32) | count);
+        if (random % 10 == 0) {
+            return 300 * 60;
+        }
+        return 2 * 60 + static_cast<std::uint32_t>((random >> 8) % (118 * 60));
+    }
+    
+    struct Workload {
+        std::size_t timers;
+        std::uint64_t ticks;
+        std::size_t refreshesPerTick;
+    };
+    
+    struct Result {
+        double ms = 0;
+        std::uint64_t expired = 0;
+        std::uint64_t checksum = 0;
+    };
+    
+    // Calls refresh(id) for this tick's refreshed timers
+    template<class Refresh>
+    void refreshTimers(const Workload& workload, std::uint64_t tick, Refresh refresh) {
+        for (std::size_t j = 0; j < workload.refreshesPerTick; ++j) {
+            refresh(static_cast<std::uint32_t>(mix(tick * 7919 + j) % workload.timers));
+        }
+    }
+    
+    Result runScan(const Workload& workload) {
+        Result result;
+        std::vector<std::uint32_t> counts(workload.timers, 0);
+        std::vector<std::uint32_t> remaining(workload.timers);
+        for (std::uint32_t id = 0; id < workload.timers; ++id) {
+            remaining[id] = delayFor(id, 0);
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t tick = 0; tick < workload.ticks; ++tick) {
+            refreshTimers(workload, tick, [&](std::uint32_t id) { remaining[id] = delayFor(id, ++counts[id]); });
+            for (std::uint32_t id = 0; id < workload.timers; ++id) {
+                if (--remaining[id] == 0) {
+                    ++result.expired;
+                    result.checksum += (tick + 1) * (id + 1);
+                    remaining[id] = delayFor(id, ++counts[id]);
+                }
+            }
+        }
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    
+    Result runHeap(const Workload& workload) {
+        Result result;
+        // Expiry tick, and the timer's restart count above its id; an entry
+        // whose count is stale was refreshed and is skipped on pop
+        typedef std::pair<std::uint64_t, std::uint64_t> Entry;
+        std::vector<std::uint32_t> counts(workload.timers, 0);
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+        auto push = [&](std::uint64_t expiry, std::uint32_t id) {
+            heap.push(Entry(expiry, static_cast<std::uint64_t>(counts[id]) << 32 | id));
+        };
+        for (std::uint32_t id = 0; id < workload.timers; ++id) {
+            push(delayFor(id, 0), id);
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t tick = 0; tick < workload.ticks; ++tick) {
+            refreshTimers(workload, tick, [&](std::uint32_t id) {
+                std::uint32_t delay = delayFor(id, ++counts[id]);
+                push(tick + delay, id);
+            });
+            std::uint64_t now = tick + 1;
+            while (!heap.empty() && heap.top().first <= now) {
+                Entry entry = heap.top();
+                heap.pop();
+                std::uint32_t id = static_cast<std::uint32_t>(entry.second);
+                if (counts[id] != entry.second >> 32) {
+                    continue;
+                }
+                ++result.expired;
+                result.checksum += now * (id + 1);
+                std::uint32_t delay = delayFor(id, ++counts[id]);
+                push(now + delay, id);
+            }
+        }
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+    
+    Result runWheel(const Workload& workload) {
+        Result result;
+        std::vector<std::uint32_t> counts(workload.timers, 0);
+        std::vector<TimerHandle> handles(workload.timers);
+        TimingWheel wheel;
+        for (std::uint32_t id = 0; id < workload.timers; ++id) {
+            handles[id] = wheel.schedule(delayFor(id, 0), 0, id);
+        }
+        wheel.setOnExpired([&](const std::vector<ExpiredTimer>& batch) {
+            for (const ExpiredTimer& timer : batch) {
+                std::uint32_t id = static_cast<std::uint32_t>(timer.payload);
+                ++result.expired;
+                result.checksum += wheel.getNow() * (id + 1);
+                handles[id] = wheel.schedule(delayFor(id, ++counts[id]), 0, id);
+            }
+        });
+        
+        auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t tick = 0; tick < workload.ticks; ++tick) {
+            refreshTimers(workload, tick, [&](std::uint32_t id) {
+                wheel.cancel(handles[id]);
+                handles[id] = wheel.schedule(delayFor(id, ++counts[id]), 0, id);
+            });
+            wheel.advance();
+        }
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    Workload workload;
+    workload.timers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    workload.ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 60 * 60 * 5;
+    workload.refreshesPerTick = workload.timers / 1000;
+    if (workload.timers == 0) {
+        std::printf("Need at least one timer\n");
+        return 1;
+    }
+    
+    std::printf("%zu timers, %llu ticks, %zu refreshes per tick\n", workload.timers,
+                static_cast<unsigned long long>(workload.ticks), workload.refreshesPerTick);
+    
+    const char* names[] = { "scan", "heap", "wheel" };
+    Result results[] = { runScan(workload), runHeap(workload), runWheel(workload) };
+    for (int i = 0; i < 3; ++i) {
+        bool matches = results[i].expired == results[0].expired && results[i].checksum == results[0].checksum;
+        std::printf("%-6s %9.1f ms %8.2f us/tick  %llu expired  %s\n", names[i], results[i].ms,
+                    results[i].ms * 1000 / workload.ticks, static_cast<unsigned long long>(results[i].expired),
+                    matches ? "ok" : "MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "BattleSimulation.h"
+#include <algorithm>
+
+namespace {
+    const std::uint32_t NO_TARGET = 0xFFFFFFFFu;
+}
+
+void CombatantArrays::resize(std::size_t count) {
+    team.resize(count, 0);
+    level.resize(count, 1);
+    health.resize(count, 0);
+    maxHealth.resize(count, 0);
+    power.resize(count, 0);
+    maxPower.resize(count, 0);
+    for (std::vector<float>& values : stats) {
+        values.resize(count, 0);
+    }
+    actionTimer.resize(count, 0);
+    pendingDamage.resize(count, 0);
+    damageDealt.resize(count, 0);
+    target.resize(count, NO_TARGET);
+    status.resize(count, 0);
+    abilityBegin.resize(count, 0);
+    abilityCount.resize(count, 0);
+}
+
+void CombatantArrays::clear() {
+    resize(0);
+}
+
+void AbilityArrays::clear() {
+    damage.clear();
+    powerCost.clear();
+    cooldown.clear();
+    remaining.clear();
+    levelRequirement.clear();
+    damageDealt.clear();
+    source.clear();
+}
+
+BattleSimulation::BattleSimulation(std::uint32_t seed, const BattleSettings& battleSettings)
+    : settings(battleSettings), tickCount(0) {
+    reset(seed);
+}
+
+void BattleSimulation::reset(std::uint32_t seed) {
+    combatants.clear();
+    abilities.clear();
+    for (std::size_t team = 0; team < TEAM_COUNT; ++team) {
+        alive[team].clear();
+        targetCursor[team] = 0;
+    }
+    // xorshift32 gets stuck at zero
+    rngState = seed != 0 ? seed : 0x9E3779B9u;
+    tickCount = 0;
+}
+
+float BattleSimulation::nextRandom() {
+    // xorshift32, returns [0, 1)
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+std::uint32_t BattleSimulation::addCombatant(const Character& character, std::size_t team, int level) {
+    std::uint32_t slot = static_cast<std::uint32_t>(combatants.size());
+    combatants.resize(slot + 1);
+    
+    combatants.team[slot] = static_cast<std::uint8_t>(team);
+    combatants.level[slot] = level;
+    for (std::size_t stat = 0; stat < BASE_STAT_COUNT; ++stat) {
+        combatants.stats[stat][slot] = static_cast<float>(character.baseStats[stat]);
+    }
+    combatants.maxHealth[slot] = combatants.health[slot] = combatants.stat(Stat::Health, slot);
+    combatants.maxPower[slot] = combatants.power[slot] = combatants.stat(Stat::DevilFruitPower, slot);
+    
+    // Stagger the first actions so a team does not strike in lockstep
+    float interval = settings.baseActionInterval * 100 / (100 + combatants.stat(Stat::Speed, slot));
+    combatants.actionTimer[slot] = interval * nextRandom();
+    
+    combatants.abilityBegin[slot] = static_cast<std::uint32_t>(abilities.size());
+    if (character.devilFruit) {
+        for (const DevilFruitAbility& ability : character.devilFruit->abilities) {
+            // Abilities without damage are buffs, which the core does not model
+            if (ability.baseDamage <= 0) {
+                continue;
+            }
+            abilities.damage.push_back(static_cast<float>(ability.baseDamage));
+            abilities.powerCost.push_back(static_cast<float>(ability.powerCost));
+            abilities.cooldown.push_back(ability.cooldown);
+            abilities.remaining.push_back(0);
+            abilities.levelRequirement.push_back(ability.levelRequirement);
+            abilities.damageDealt.push_back(0);
+            abilities.source.push_back(&ability);
+        }
+    }
+    combatants.abilityCount[slot] = static_cast<std::uint32_t>(abilities.size()) - combatants.abilityBegin[slot];
+    
+    alive[team].push_back(slot);
+    return slot;
+}
+
+std::uint32_t BattleSimulation::pickTarget(std::size_t team) {
+    const std::vector<std::uint32_t>& candidates = alive[team];
+    if (candidates.empty()) {
+        return NO_TARGET;
+    }
+    // Round robin spreads a team's attacks over the other team
+    targetCursor[team] = (targetCursor[team] + 1) % candidates.size();
+    return candidates[targetCursor[team]];
+}
+
+void BattleSimulation::act(std::uint32_t slot) {
+    std::uint32_t target = combatants.target[slot];
+    if (target == NO_TARGET || combatants.health[target] <= 0) {
+        target = pickTarget(1 - combatants.team[slot]);
+        combatants.target[slot] = target;
+        if (target == NO_TARGET) {
+            return;
+        }
+    }
+    
+    // Strongest ability that is ready, affordable and unlocked
+    std::uint32_t best = NO_TARGET;
+    float damage = 0;
+    std::uint32_t end = combatants.abilityBegin[slot] + combatants.abilityCount[slot];
+    for (std::uint32_t ability = combatants.abilityBegin[slot]; ability < end; ++ability) {
+        if (abilities.remaining[ability] <= 0 && abilities.powerCost[ability] <= combatants.power[slot]
+            && abilities.levelRequirement[ability] <= combatants.level[slot] && abilities.damage[ability] > damage) {
+            best = ability;
+            damage = abilities.damage[ability];
+        }
+    }
+    if (best != NO_TARGET) {
+        combatants.power[slot] -= abilities.powerCost[best];
+        abilities.remaining[best] = abilities.cooldown[best];
+    }
+    
+    damage += combatants.stat(Stat::Attack, slot);
+    damage *= 100 / (100 + combatants.stat(Stat::Defense, target));
+    damage *= 1 + settings.damageVariance * (2 * nextRandom() - 1);
+    combatants.pendingDamage[target] += damage;
+    combatants.damageDealt[slot] += damage;
+    if (best != NO_TARGET) {
+        abilities.damageDealt[best] += damage;
+    }
+    
+    combatants.actionTimer[slot] += settings.baseActionInterval * 100 / (100 + combatants.stat(Stat::Speed, slot));
+}
+
+void BattleSimulation::removeDefeated(std::size_t team) {
+    std::vector<std::uint32_t>& slots = alive[team];
+    std::size_t kept = 0;
+    for (std::uint32_t slot : slots) {
+        if (combatants.health[slot] > 0) {
+            slots[kept++] = slot;
+        } else {
+            combatants.health[slot] = 0;
+            combatants.status[slot] |= STATUS_DEFEATED;
+        }
+    }
+    slots.resize(kept);
+}
+
+void BattleSimulation::tick(float deltaTime) {
+    if (isOver()) {
+        return;
+    }
+    ++tickCount;
+    
+    // Timers and regeneration, over every slot so the loops stay branch-free
+    std::size_t count = combatants.size();
+    float* timer = combatants.actionTimer.data();
+    float* power = combatants.power.data();
+    const float* maxPower = combatants.maxPower.data();
+    float regen = settings.powerRegen * deltaTime;
+    for (std::size_t i = 0; i < count; ++i) {
+        timer[i] -= deltaTime;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        power[i] = std::min(maxPower[i], power[i] + maxPower[i] * regen);
+    }
+    float* remaining = abilities.remaining.data();
+    for (std::size_t i = 0; i < abilities.size(); ++i) {
+        remaining[i] = std::max(0.0f, remaining[i] - deltaTime);
+    }
+    
+    // Every ready combatant acts on the health at the start of the tick;
+    // damage accumulates and lands afterwards
+    for (std::size_t team = 0; team < TEAM_COUNT; ++team) {
+        for (std::uint32_t slot : alive[team]) {
+            if (timer[slot] > 0) {
+                continue;
+            }
+            if (combatants.status[slot] & STATUS_STUNNED) {
+                timer[slot] = 0;
+                continue;
+            }
+            act(slot);
+        }
+    }
+    
+    float* health = combatants.health.data();
+    float* pending = combatants.pendingDamage.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        health[i] -= pending[i];
+        pending[i] = 0;
+    }
+    for (std::size_t team = 0; team < TEAM_COUNT; ++team) {
+        removeDefeated(team);
+    }
+}
+
+int BattleSimulation::getWinner() const {
+    if (alive[0].empty() == alive[1].empty()) {
+        return -1;
+    }
+    return alive[0].empty() ? 1 : 0;
+}
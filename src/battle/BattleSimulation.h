@@ -0,0 +1,107 @@
+#pragma once
+#include "../data/GameRecords.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Combatant status bits
+const std::uint32_t STATUS_DEFEATED = 1u << 0;
+const std::uint32_t STATUS_STUNNED = 1u << 1; // Skips its actions
+
+const std::size_t TEAM_COUNT = 2;
+
+// Structure-of-arrays combatant state, indexed by slot. Every attribute
+// lives in its own contiguous array so each phase of a tick is a tight
+// loop over just the arrays it touches. This header has no SFML dependency.
+struct CombatantArrays {
+    std::vector<std::uint8_t> team;
+    std::vector<std::int32_t> level;
+    std::vector<float> health;
+    std::vector<float> maxHealth;
+    std::vector<float> power;      // Devil fruit power, spent on abilities
+    std::vector<float> maxPower;
+    std::array<std::vector<float>, BASE_STAT_COUNT> stats; // stats[Stat][slot]
+    std::vector<float> actionTimer; // Seconds until the next action
+    std::vector<float> pendingDamage;
+    std::vector<float> damageDealt; // Over the whole battle, abilities included
+    std::vector<std::uint32_t> target;
+    std::vector<std::uint32_t> status;
+    std::vector<std::uint32_t> abilityBegin; // Into AbilityArrays
+    std::vector<std::uint32_t> abilityCount;
+    
+    std::size_t size() const { return team.size(); }
+    void resize(std::size_t count);
+    void clear();
+    
+    float& stat(Stat which, std::size_t slot) { return stats[static_cast<std::size_t>(which)][slot]; }
+    float stat(Stat which, std::size_t slot) const { return stats[static_cast<std::size_t>(which)][slot]; }
+};
+
+// Devil fruit abilities of every combatant, one entry per ability
+struct AbilityArrays {
+    std::vector<float> damage;
+    std::vector<float> powerCost;
+    std::vector<float> cooldown;
+    std::vector<float> remaining; // Cooldown left
+    std::vector<std::int32_t> levelRequirement;
+    std::vector<float> damageDealt;
+    std::vector<const DevilFruitAbility*> source;
+    
+    std::size_t size() const { return damage.size(); }
+    void clear();
+};
+
+struct BattleSettings {
+    // A combatant with 0 speed acts this often; 100 speed halves it
+    float baseActionInterval = 1.0f;
+    // Devil fruit power regained per second, as a fraction of the maximum
+    float powerRegen = 0.02f;
+    // Damage is scaled by a random factor in [1 - variance, 1 + variance]
+    float damageVariance = 0.1f;
+};
+
+// Real-time battle between two teams, usable in game and headless. Each
+// tick advances timers, lets every ready combatant use its strongest
+// affordable ability (or a basic attack) on its target, then applies the
+// accumulated damage in one pass:
+//
+//     damage = (ability damage + attack) * 100 / (100 + target defense)
+//
+// Everything is deterministic for a given seed.
+class BattleSimulation {
+private:
+    BattleSettings settings;
+    CombatantArrays combatants;
+    AbilityArrays abilities;
+    std::vector<std::uint32_t> alive[TEAM_COUNT]; // Slots still standing
+    std::uint32_t targetCursor[TEAM_COUNT];
+    std::uint32_t rngState;
+    std::uint64_t tickCount;
+    
+    float nextRandom();
+    std::uint32_t pickTarget(std::size_t team);
+    void act(std::uint32_t slot);
+    void removeDefeated(std::size_t team);
+
+public:
+    explicit BattleSimulation(std::uint32_t seed = 0x9E3779B9u, const BattleSettings& battleSettings = BattleSettings());
+    
+    // Returns the new slot; level gates the character's abilities
+    std::uint32_t addCombatant(const Character& character, std::size_t team, int level = 1);
+    // Removes every combatant and reseeds
+    void reset(std::uint32_t seed);
+    
+    void tick(float deltaTime);
+    
+    bool isOver() const { return alive[0].empty() || alive[1].empty(); }
+    // The team still standing, or -1 while both are (or neither is)
+    int getWinner() const;
+    std::size_t getAliveCount(std::size_t team) const { return alive[team].size(); }
+    std::uint64_t getTickCount() const { return tickCount; }
+    
+    const CombatantArrays& getCombatants() const { return combatants; }
+    // For effects that change stats or status mid-battle
+    CombatantArrays& getCombatants() { return combatants; }
+    const AbilityArrays& getAbilities() const { return abilities; }
+};
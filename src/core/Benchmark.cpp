@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+#include "../scenes/MainMenuScene.h"
+#include "../debug/Instrumentation.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace {
+    // Nearest-rank percentile over an already sorted sample
+    double percentile(const std::vector<double>& sorted, double p) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+    
+    nlohmann::json summarize(std::vector<double> samples) {
+        std::sort(samples.begin(), samples.end());
+        double sum = std::accumulate(samples.begin(), samples.end(), 0.0);
+        
+        nlohmann::json stats;
+        stats["mean"] = samples.empty() ? 0.0 : sum / samples.size();
+        stats["median"] = percentile(samples, 50);
+        stats["p95"] = percentile(samples, 95);
+        stats["p99"] = percentile(samples, 99);
+        stats["min"] = samples.empty() ? 0.0 : samples.front();
+        stats["max"] = samples.empty() ? 0.0 : samples.back();
+        return stats;
+    }
+    
+    // Sweeps the pointer up and down the button column so hover states change
+    sf::Vector2i syntheticPointer(float time) {
+        float sweep = 0.5f + 0.5f * std::sin(time * 1.5f);
+        return sf::Vector2i(640, static_cast<int>(300 + sweep * 340));
+    }
+}
+
+nlohmann::json runSceneBenchmark(const BenchmarkOptions& options) {
+    typedef std::chrono::steady_clock Clock;
+    
+    MainMenuScene scene(true, options.loop);
+    
+    std::vector<double> frameMs;
+    frameMs.reserve(options.frames);
+#ifdef OPMON_ENABLE_PROFILER
+    std::vector<std::vector<double>> phaseMs(PROFILE_PHASE_COUNT);
+    for (auto& samples : phaseMs) {
+        samples.reserve(options.frames);
+    }
+#endif
+    
+    float time = 0;
+    int totalFrames = options.warmupFrames + options.frames;
+    auto benchStart = Clock::now();
+    
+    for (int frame = 0; frame < totalFrames && scene.isOpen(); ++frame) {
+        scene.setSyntheticMouse(syntheticPointer(time));
+        
+        auto start = Clock::now();
+        scene.step(options.deltaTime);
+        auto end = Clock::now();
+        time += options.deltaTime;
+        
+        if (frame < options.warmupFrames) {
+            benchStart = end;
+            continue;
+        }
+        
+        frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+#ifdef OPMON_ENABLE_PROFILER
+        const Profiler& profiler = Profiler::instance();
+        const Profiler::FrameRecord& record = profiler.frame(profiler.size() - 1);
+        for (std::size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+            phaseMs[i].push_back(record.phaseMs[i]);
+        }
+#endif
+    }
+    
+    double wallSeconds = std::chrono::duration<double>(Clock::now() - benchStart).count();
+    
+    nlohmann::json report;
+    report["scene"] = "MainMenuScene";
+    report["target"] = "offscreen";
+    report["frames"] = frameMs.size();
+    report["warmupFrames"] = options.warmupFrames;
+    report["deltaTime"] = options.deltaTime;
+    report["tickRate"] = options.loop.tickRate;
+    report["wallSeconds"] = wallSeconds;
+    report["framesPerSecond"] = wallSeconds > 0 ? frameMs.size() / wallSeconds : 0.0;
+    report["frameTimeMs"] = summarize(frameMs);
+    
+    nlohmann::json phases = nlohmann::json::object();
+#ifdef OPMON_ENABLE_PROFILER
+    for (std::size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+        phases[Profiler::phaseName(static_cast<ProfilePhase>(i))] = summarize(phaseMs[i]);
+    }
+#endif
+    report["phasesMs"] = phases;
+    
+    return report;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "GameLoop.h"
+#include <nlohmann/json.hpp>
+
+struct BenchmarkOptions {
+    int frames = 600;
+    int warmupFrames = 30;
+    float deltaTime = 1.0f / 60.0f;
+    GameLoopSettings loop;
+};
+
+// Runs the main menu headless for a fixed number of frames with a synthetic
+// delta and pointer, and returns frame-time statistics as JSON.
+nlohmann::json runSceneBenchmark(const BenchmarkOptions& options);
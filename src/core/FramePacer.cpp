@@ -0,0 +1,140 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#define OPMON_CPU_RELAX() _mm_pause()
+#else
+#define OPMON_CPU_RELAX() std::this_thread::yield()
+#endif
+
+FramePacer::FramePacer(const FramePacerSettings& pacerSettings) : settings(pacerSettings) {
+    setTargetRate(settings.targetRate);
+    reset();
+}
+
+void FramePacer::setTargetRate(float rate) {
+    settings.targetRate = std::max(0.0f, rate);
+    if (settings.targetRate > 0) {
+        period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.targetRate));
+    } else {
+        period = Clock::duration::zero();
+    }
+    started = false;
+}
+
+void FramePacer::reset() {
+    started = false;
+    historyHead = 0;
+    historyCount = 0;
+    frameCount = 0;
+    missedDeadlines = 0;
+}
+
+void FramePacer::sleepUntil(Clock::time_point time) {
+#if defined(__linux__)
+    // steady_clock is CLOCK_MONOTONIC on Linux, so the deadline maps directly
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    if (sinceEpoch <= 0) {
+        return;
+    }
+    timespec target;
+    target.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+    target.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(time);
+#endif
+}
+
+void FramePacer::wait() {
+    if (period == Clock::duration::zero()) {
+        return;
+    }
+    
+    Clock::time_point now = Clock::now();
+    if (!started) {
+        started = true;
+        deadline = now;
+        return;
+    }
+    
+    if (now > deadline) {
+        ++missedDeadlines;
+        return;
+    }
+    
+    auto margin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(settings.spinMargin));
+    if (deadline - now > margin) {
+        sleepUntil(deadline - margin);
+    }
+    
+    // The swap will block until vblank anyway, so don't burn the margin
+    if (settings.vsync) {
+        return;
+    }
+    
+    while (Clock::now() < deadline) {
+        OPMON_CPU_RELAX();
+    }
+}
+
+void FramePacer::framePresented() {
+    Clock::time_point now = Clock::now();
+    
+    if (frameCount > 0 && period != Clock::duration::zero()) {
+        float intervalMs = std::chrono::duration<float, std::milli>(now - lastPresent).count();
+        float periodMs = std::chrono::duration<float, std::milli>(period).count();
+        errorHistory[historyHead] = std::fabs(intervalMs - periodMs);
+        historyHead = (historyHead + 1) % HISTORY_SIZE;
+        historyCount = std::min(historyCount + 1, HISTORY_SIZE);
+    }
+    lastPresent = now;
+    ++frameCount;
+    
+    if (!started) {
+        return;
+    }
+    
+    if (settings.vsync) {
+        // Present returned right after vblank: the next frame is due one period later
+        deadline = now + period;
+    } else {
+        deadline += period;
+        
+        // Fell more than a whole frame behind: resync rather than rushing to catch up
+        if (now > deadline) {
+            deadline = now + period;
+        }
+    }
+}
+
+FramePacer::Stats FramePacer::getStats() const {
+    Stats stats;
+    stats.frames = frameCount;
+    stats.missedDeadlines = missedDeadlines;
+    if (historyCount == 0) {
+        return stats;
+    }
+    
+    std::array<float, HISTORY_SIZE> sorted;
+    std::copy(errorHistory.begin(), errorHistory.begin() + historyCount, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + historyCount);
+    
+    float sum = 0;
+    for (std::size_t i = 0; i < historyCount; ++i) {
+        sum += sorted[i];
+    }
+    stats.meanErrorMs = sum / historyCount;
+    stats.p99ErrorMs = sorted[std::min(historyCount - 1, (historyCount * 99) / 100)];
+    stats.maxErrorMs = sorted[historyCount - 1];
+    return stats;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct FramePacerSettings {
+    // Frames per second to pace to, 0 for uncapped
+    float targetRate = 60;
+    
+    // With vsync the buffer swap does the final alignment, so the pacer
+    // only sleeps to just before the deadline and re-anchors on each present
+    bool vsync = false;
+    
+    // How long before the deadline to stop sleeping and spin instead
+    float spinMargin = 0.002f;
+};
+
+// Replaces sf::Window::setFramerateLimit. Sleeps with clock_nanosleep on an
+// absolute deadline where available, then spin-waits the last couple of
+// milliseconds to absorb scheduler oversleep.
+class FramePacer {
+public:
+    static constexpr std::size_t HISTORY_SIZE = 240;
+    
+    struct Stats {
+        std::uint64_t frames = 0;
+        std::uint64_t missedDeadlines = 0;
+        
+        // |frame interval - target period| over the recent history
+        float meanErrorMs = 0;
+        float p99ErrorMs = 0;
+        float maxErrorMs = 0;
+    };
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    
+    FramePacerSettings settings;
+    Clock::duration period;
+    Clock::time_point deadline;
+    Clock::time_point lastPresent;
+    bool started;
+    
+    std::array<float, HISTORY_SIZE> errorHistory;
+    std::size_t historyHead;
+    std::size_t historyCount;
+    std::uint64_t frameCount;
+    std::uint64_t missedDeadlines;
+    
+    static void sleepUntil(Clock::time_point time);
+
+public:
+    explicit FramePacer(const FramePacerSettings& pacerSettings = FramePacerSettings());
+    
+    void setTargetRate(float rate);
+    float getTargetRate() const { return settings.targetRate; }
+    
+    // Call right before presenting; blocks until the frame is due
+    void wait();
+    
+    // Call right after presenting
+    void framePresented();
+    
+    void reset();
+    Stats getStats() const;
+};
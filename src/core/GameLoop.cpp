@@ -0,0 +1,84 @@
+#include "GameLoop.h"
+#include "../debug/Instrumentation.h"
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <cmath>
+
+GameLoop::GameLoop(const GameLoopSettings& loopSettings)
+    : settings(loopSettings), accumulator(0), alpha(0), tickCount(0), droppedTicks(0), skippedRenders(0),
+      pacer(loopSettings.pacing), pacing(false), idle(false) {
+    settings.tickRate = std::max(1.0f, settings.tickRate);
+    settings.maxTicksPerFrame = std::max(1, settings.maxTicksPerFrame);
+    tickDelta = 1.0f / settings.tickRate;
+}
+
+void GameLoop::run(Scene& scene) {
+    sf::Clock frameClock;
+    pacing = true;
+    pacer.reset();
+    while (scene.isOpen()) {
+        frame(scene, frameClock.restart().asSeconds());
+    }
+    pacing = false;
+}
+
+void GameLoop::frame(Scene& scene, float frameTime) {
+    OPMON_PROFILE_BEGIN_FRAME();
+    
+    scene.handleEvents();
+    
+    // Drop to the idle rate while paused and restore the normal one after
+    bool paused = scene.isPaused();
+    if (paused != idle) {
+        idle = paused;
+        pacer.setTargetRate(idle ? settings.idleFrameRate : settings.pacing.targetRate);
+    }
+    
+    if (paused) {
+        accumulator = 0;
+    } else {
+        accumulator += std::min(std::max(frameTime, 0.0f), settings.maxFrameTime);
+    }
+    
+    int ticks = 0;
+    while (accumulator >= tickDelta && ticks < settings.maxTicksPerFrame) {
+        scene.fixedUpdate(tickDelta);
+        accumulator -= tickDelta;
+        ++tickCount;
+        ++ticks;
+    }
+    
+    // Still behind after the tick budget: drop the backlog instead of
+    // falling further behind every frame
+    if (accumulator >= tickDelta) {
+        droppedTicks += static_cast<std::uint64_t>(accumulator / tickDelta);
+        accumulator = std::fmod(accumulator, tickDelta);
+    }
+    
+    alpha = accumulator / tickDelta;
+    
+    // Nothing visible changed: keep the previous frame on screen
+    bool redraw = scene.needsRedraw();
+    if (redraw) {
+        scene.render(alpha);
+    } else {
+        ++skippedRenders;
+        OPMON_PROFILE_RENDER_SKIPPED();
+    }
+    
+    if (pacing) {
+        OPMON_PROFILE_SCOPE(ProfilePhase::Wait);
+        pacer.wait();
+    }
+    
+    if (redraw) {
+        scene.present();
+    }
+    
+    // Marks the frame boundary even when nothing was presented
+    if (pacing) {
+        pacer.framePresented();
+    }
+    
+    OPMON_PROFILE_END_FRAME();
+}
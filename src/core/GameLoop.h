@@ -0,0 +1,51 @@
+#pragma once
+#include "../scenes/Scene.h"
+#include "FramePacer.h"
+#include <cstdint>
+
+struct GameLoopSettings {
+    float tickRate = 120;
+    
+    // Spiral-of-death protection: long frames are clamped and whatever
+    // simulation time remains after maxTicksPerFrame ticks is dropped
+    float maxFrameTime = 0.25f;
+    int maxTicksPerFrame = 8;
+    
+    // Only applied by run(); frame() is never paced
+    FramePacerSettings pacing;
+    
+    // Frame rate used while the scene reports itself paused
+    float idleFrameRate = 10;
+};
+
+// Fixed-timestep driver. Each frame runs as many fixed ticks as the elapsed
+// time allows and then renders once with the leftover fraction as alpha.
+class GameLoop {
+private:
+    GameLoopSettings settings;
+    float tickDelta;
+    float accumulator;
+    float alpha;
+    std::uint64_t tickCount;
+    std::uint64_t droppedTicks;
+    std::uint64_t skippedRenders;
+    FramePacer pacer;
+    bool pacing;
+    bool idle;
+
+public:
+    explicit GameLoop(const GameLoopSettings& loopSettings = GameLoopSettings());
+    
+    // Runs in real time until the scene closes
+    void run(Scene& scene);
+    
+    // Runs one rendered frame for frameTime seconds of elapsed time
+    void frame(Scene& scene, float frameTime);
+    
+    float getTickDelta() const { return tickDelta; }
+    float getAlpha() const { return alpha; }
+    std::uint64_t getTickCount() const { return tickCount; }
+    std::uint64_t getDroppedTicks() const { return droppedTicks; }
+    std::uint64_t getSkippedRenders() const { return skippedRenders; }
+    const FramePacer& getPacer() const { return pacer; }
+};
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+
+// On-disk layout of the compiled game database (game.db). Everything is
+// little-endian and 4-byte aligned; 64-bit numbers are 8-byte aligned.
+//
+//   Header
+//   Body:         containers and out-of-line numbers, addressed by offset
+//   String table: StringEntry[stringCount]
+//   String data:  NUL-terminated UTF-8
+//   Root table:   RootEntry[rootCount], one per source file
+//
+// A value is an 8-byte slot {type, data}. Depending on the type, data holds
+// the value itself (Bool, Int), a string index (String) or the file offset
+// of its payload (Int64, Double, Array, Object). Arrays are {count,
+// Slot[count]}; objects are {count, ObjectEntry[count]} sorted by key bytes.
+namespace DatabaseFormat {
+    const char MAGIC[4] = { 'O', 'P', 'D', 'B' };
+    const std::uint32_t VERSION = 1;
+    
+    enum ValueType : std::uint32_t {
+        TYPE_NULL = 0,
+        TYPE_BOOL,
+        TYPE_INT,
+        TYPE_INT64,
+        TYPE_DOUBLE,
+        TYPE_STRING,
+        TYPE_ARRAY,
+        TYPE_OBJECT,
+        TYPE_COUNT
+    };
+    
+    const std::uint32_t HEADER_SIZE = 32;
+    const std::uint32_t SLOT_SIZE = 8;
+    const std::uint32_t OBJECT_ENTRY_SIZE = 4 + SLOT_SIZE;
+    const std::uint32_t STRING_ENTRY_SIZE = 8;
+    const std::uint32_t ROOT_ENTRY_SIZE = 4 + SLOT_SIZE;
+    
+    // Header field offsets
+    const std::uint32_t HEADER_VERSION = 4;
+    const std::uint32_t HEADER_FILE_SIZE = 8;
+    const std::uint32_t HEADER_ROOT_COUNT = 12;
+    const std::uint32_t HEADER_ROOT_TABLE = 16;
+    const std::uint32_t HEADER_STRING_COUNT = 20;
+    const std::uint32_t HEADER_STRING_TABLE = 24;
+    const std::uint32_t HEADER_STRING_DATA = 28;
+    
+    // Nesting limit checked when a file is opened
+    const int MAX_DEPTH = 64;
+    
+    // Byte-order independent loads; compile to plain loads on little-endian hosts
+    inline std::uint32_t readU32(const std::uint8_t* pointer) {
+        return static_cast<std::uint32_t>(pointer[0]) | (static_cast<std::uint32_t>(pointer[1]) << 8)
+             | (static_cast<std::uint32_t>(pointer[2]) << 16) | (static_cast<std::uint32_t>(pointer[3]) << 24);
+    }
+    
+    inline std::uint64_t readU64(const std::uint8_t* pointer) {
+        return static_cast<std::uint64_t>(readU32(pointer)) | (static_cast<std::uint64_t>(readU32(pointer + 4)) << 32);
+    }
+}
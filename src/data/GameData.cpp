@@ -0,0 +1,218 @@
+#include "GameData.h"
+#include "GameDatabase.h"
+#include "JsonTape.h"
+#include "ShippedIds.h"
+#include "StructReader.h"
+#include <iostream>
+
+template<class Source>
+bool GameData::read(const char* name, const Source& source, void* record, const TypeInfo& type) {
+    StructReader reader(record, type, getReadContext());
+    if (!source.replay(reader)) {
+        std::cout << "Warning: " << name << ": " << reader.getError() << std::endl;
+        return false;
+    }
+    if (reader.getMismatchCount() > 0) {
+        std::cout << "Warning: " << name << ": " << reader.getMismatchCount() << " value(s) skipped, first "
+                  << reader.getError() << std::endl;
+    }
+    return true;
+}
+
+bool GameData::loadFromDatabase(const GameDatabase& database) {
+    clear();
+    
+    DbValue characterRoot = database.root("characters");
+    DbValue itemRoot = database.root("items");
+    DbValue locationRoot = database.root("locations");
+    DbValue dialogueRoot = database.root("dialogue");
+    if (!characterRoot.isObject() || !itemRoot.isObject() || !locationRoot.isObject() || !dialogueRoot.isObject()) {
+        std::cout << "Warning: game database is missing the characters, items, locations or dialogue root" << std::endl;
+        return false;
+    }
+    
+    bool loaded = read("characters", characterRoot, &characters, typeOf<CharacterFile>())
+        && read("items", itemRoot, &items, typeOf<ItemFile>())
+        && read("locations", locationRoot, &locations, typeOf<LocationFile>())
+        && read("dialogue", dialogueRoot, &dialogue, typeOf<DialogueFile>());
+    if (loaded) {
+        link();
+    }
+    return loaded;
+}
+
+bool GameData::loadFromJson(const std::string& dataDirectory) {
+    clear();
+    
+    struct Source {
+        const char* file;
+        void* record;
+        const TypeInfo& type;
+    };
+    const Source sources[] = {
+        { "characters.json", &characters, typeOf<CharacterFile>() },
+        { "items.json", &items, typeOf<ItemFile>() },
+        { "locations.json", &locations, typeOf<LocationFile>() },
+        { "dialogue/characters.json", &dialogue, typeOf<DialogueFile>() }
+    };
+    
+    JsonTape tape;
+    for (const Source& source : sources) {
+        std::string path = dataDirectory + "/" + source.file;
+        if (!tape.loadFromFile(path)) {
+            std::cout << "Warning: " << path << ": " << tape.getError() << std::endl;
+            return false;
+        }
+        if (!read(source.file, tape, source.record, source.type)) {
+            return false;
+        }
+    }
+    
+    link();
+    return true;
+}
+
+void GameData::indexRecords() {
+    StringInterner& ids = StringInterner::instance();
+    
+    for (const auto& character : characters.characters) {
+        if (!characterById.add(character.first, character.second)) {
+            std::cout << "Warning: characters: duplicate character '" << ids.name(character.first) << "'" << std::endl;
+        }
+    }
+    for (const auto& enemy : characters.enemies) {
+        if (!enemyById.add(enemy.first, enemy.second)) {
+            std::cout << "Warning: characters: duplicate enemy '" << ids.name(enemy.first) << "'" << std::endl;
+        }
+    }
+    for (const auto& category : items.items) {
+        for (const auto& item : category.second) {
+            if (!itemById.add(item.first, item.second)) {
+                std::cout << "Warning: items: duplicate item '" << ids.name(item.first) << "'" << std::endl;
+            }
+        }
+    }
+    for (const auto& location : locations.locations) {
+        if (!locationById.add(location.first, location.second)) {
+            std::cout << "Warning: locations: duplicate location '" << ids.name(location.first) << "'" << std::endl;
+        }
+    }
+    for (const auto& region : locations.regions) {
+        regionById.add(region.first, region.second);
+    }
+    // Locations name their region by display name ("East Blue"), so
+    // regions can be found by that too
+    for (const auto& region : locations.regions) {
+        regionById.add(ids.find(region.second.name), region.second);
+    }
+    for (const auto& speaker : dialogue.dialogues) {
+        dialogueBySpeaker.add(speaker.first, speaker.second);
+    }
+}
+
+template<class T>
+void GameData::resolve(Ref<T>& ref, const IdTable<T>& table, const char* file, StringId owner, const char* kind) {
+    if (!ref.id.isValid()) {
+        return;
+    }
+    
+    ref.target = table.find(ref.id);
+    if (!ref.target) {
+        StringInterner& ids = StringInterner::instance();
+        std::cout << "Warning: " << file << ": " << ids.name(owner) << " references unknown " << kind << " '"
+                  << ids.name(ref.id) << "'" << std::endl;
+        ++danglingCount;
+    }
+}
+
+void GameData::link() {
+    indexRecords();
+    
+    for (auto& enemy : characters.enemies) {
+        if (enemy.second.dropTable) {
+            for (ItemDrop& drop : enemy.second.dropTable->items) {
+                resolve(drop.item, itemById, "characters", enemy.first, "item");
+            }
+        }
+    }
+    for (auto& character : characters.characters) {
+        resolve(character.second.joinLocation, locationById, "characters", character.first, "location");
+        for (RecruitmentRequirement& requirement : character.second.recruitmentRequirements) {
+            // Other requirement kinds target quests, which have no records yet
+            if (requirement.type == ID_DEFEAT) {
+                resolve(requirement.target, enemyById, "characters", character.first, "enemy");
+            }
+        }
+    }
+    
+    for (auto& set : items.itemSets) {
+        for (Ref<Item>& item : set.second.items) {
+            resolve(item, itemById, "items", set.first, "item");
+        }
+    }
+    for (auto& shop : items.shopInventories) {
+        for (Ref<Item>& item : shop.second) {
+            resolve(item, itemById, "items", shop.first, "item");
+        }
+    }
+    
+    for (auto& entry : locations.locations) {
+        Location& location = entry.second;
+        resolve(location.region, regionById, "locations", entry.first, "region");
+        for (Ref<Location>& connected : location.connectedLocations) {
+            resolve(connected, locationById, "locations", entry.first, "location");
+        }
+        for (LocationShop& shop : location.shops) {
+            for (Ref<Item>& item : shop.inventory) {
+                resolve(item, itemById, "locations", shop.id, "item");
+            }
+        }
+        for (RandomEncounter& encounter : location.randomEncounters) {
+            for (auto& group : encounter.enemyGroups) {
+                for (Ref<Character>& enemy : group) {
+                    resolve(enemy, enemyById, "locations", entry.first, "enemy");
+                }
+            }
+        }
+    }
+    
+    // Response targets are node names local to the speaker
+    IdTable<DialogueNode> nodes;
+    for (auto& speaker : dialogue.dialogues) {
+        nodes.clear();
+        for (const auto& node : speaker.second) {
+            nodes.add(node.first, node.second);
+        }
+        for (auto& node : speaker.second) {
+            for (DialogueLine& line : node.second) {
+                resolve(line.item, itemById, "dialogue", speaker.first, "item");
+                for (DialogueResponse& response : line.responses) {
+                    resolve(response.next, nodes, "dialogue", speaker.first, "node");
+                }
+            }
+        }
+    }
+    
+    if (danglingCount > 0) {
+        std::cout << "Warning: " << danglingCount << " dangling data reference(s)" << std::endl;
+    }
+}
+
+ReadContext GameData::getReadContext() {
+    return ReadContext{ strings, StringInterner::instance() };
+}
+
+void GameData::clear() {
+    characters = CharacterFile();
+    items = ItemFile();
+    locations = LocationFile();
+    dialogue = DialogueFile();
+    characterById.clear();
+    enemyById.clear();
+    itemById.clear();
+    locationById.clear();
+    regionById.clear();
+    dialogueBySpeaker.clear();
+    danglingCount = 0;
+    strings.clear();
+}
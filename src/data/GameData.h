@@ -0,0 +1,57 @@
+#pragma once
+#include "GameRecords.h"
+#include "IdTable.h"
+#include "StringArena.h"
+#include <string>
+
+class GameDatabase;
+
+// Typed character, item, location and dialogue records. Release builds
+// fill them from game.db; development builds can read assets/data directly.
+// Both paths stream SAX events into StructReader, so no DOM is built.
+// Identifiers go to the global StringInterner; other strings land in one
+// arena owned here.
+//
+// After reading, a link pass indexes every record by id and resolves each
+// Ref once, so gameplay code follows pointers instead of looking ids up.
+// References to records that do not exist are reported and left null.
+class GameData {
+private:
+    StringArena strings;
+    std::size_t danglingCount = 0;
+    
+    template<class Source>
+    bool read(const char* name, const Source& source, void* record, const TypeInfo& type);
+    void link();
+    void indexRecords();
+    
+    template<class T>
+    void resolve(Ref<T>& ref, const IdTable<T>& table, const char* file, StringId owner, const char* kind);
+
+public:
+    CharacterFile characters;
+    ItemFile items;
+    LocationFile locations;
+    DialogueFile dialogue;
+    
+    // Filled by the link pass
+    IdTable<Character> characterById;
+    IdTable<Character> enemyById;
+    IdTable<Item> itemById; // Across all categories
+    IdTable<Location> locationById;
+    IdTable<Region> regionById;
+    IdTable<RecordMap<DialogueNode>> dialogueBySpeaker;
+    
+    GameData() = default;
+    GameData(const GameData&) = delete;
+    GameData& operator=(const GameData&) = delete;
+    
+    bool loadFromDatabase(const GameDatabase& database);
+    bool loadFromJson(const std::string& dataDirectory);
+    void clear();
+    
+    // For loaders that add their own records alongside these
+    ReadContext getReadContext();
+    std::size_t getStringBytes() const { return strings.getBytesUsed(); }
+    std::size_t getDanglingCount() const { return danglingCount; }
+};
@@ -0,0 +1,346 @@
+#include "GameDatabase.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OPMON_HAVE_MMAP 1
+#endif
+
+using DatabaseFormat::readU32;
+using DatabaseFormat::readU64;
+
+std::uint32_t DbValue::data() const {
+    return readU32(slot + 4);
+}
+
+const std::uint8_t* DbValue::payload() const {
+    return db->bytes + data();
+}
+
+DatabaseFormat::ValueType DbValue::getType() const {
+    return slot ? static_cast<DatabaseFormat::ValueType>(readU32(slot)) : DatabaseFormat::TYPE_NULL;
+}
+
+bool DbValue::isNumber() const {
+    DatabaseFormat::ValueType type = getType();
+    return type == DatabaseFormat::TYPE_INT || type == DatabaseFormat::TYPE_INT64 || type == DatabaseFormat::TYPE_DOUBLE;
+}
+
+bool DbValue::asBool(bool fallback) const {
+    return isBool() ? data() != 0 : fallback;
+}
+
+std::int64_t DbValue::asInt(std::int64_t fallback) const {
+    switch (getType()) {
+        case DatabaseFormat::TYPE_INT:
+            return static_cast<std::int32_t>(data());
+        case DatabaseFormat::TYPE_INT64:
+            return static_cast<std::int64_t>(readU64(payload()));
+        case DatabaseFormat::TYPE_DOUBLE:
+            return static_cast<std::int64_t>(asDouble());
+        default:
+            return fallback;
+    }
+}
+
+double DbValue::asDouble(double fallback) const {
+    switch (getType()) {
+        case DatabaseFormat::TYPE_INT:
+        case DatabaseFormat::TYPE_INT64:
+            return static_cast<double>(asInt());
+        case DatabaseFormat::TYPE_DOUBLE: {
+            std::uint64_t bits = readU64(payload());
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        default:
+            return fallback;
+    }
+}
+
+std::string_view DbValue::asString(std::string_view fallback) const {
+    return isString() ? db->getString(data()) : fallback;
+}
+
+std::size_t DbValue::size() const {
+    return isArray() || isObject() ? readU32(payload()) : 0;
+}
+
+DbValue DbValue::at(std::size_t index) const {
+    if (index >= size()) {
+        return DbValue();
+    }
+    
+    const std::uint8_t* entries = payload() + 4;
+    if (isArray()) {
+        return DbValue(db, entries + index * DatabaseFormat::SLOT_SIZE);
+    }
+    return DbValue(db, entries + index * DatabaseFormat::OBJECT_ENTRY_SIZE + 4);
+}
+
+std::string_view DbValue::keyAt(std::size_t index) const {
+    if (!isObject() || index >= size()) {
+        return std::string_view();
+    }
+    return db->getString(readU32(payload() + 4 + index * DatabaseFormat::OBJECT_ENTRY_SIZE));
+}
+
+DbValue DbValue::find(std::string_view key) const {
+    if (!isObject()) {
+        return DbValue();
+    }
+    
+    // Keys are sorted by their bytes when the database is compiled
+    const std::uint8_t* entries = payload() + 4;
+    std::size_t low = 0;
+    std::size_t high = readU32(payload());
+    while (low < high) {
+        std::size_t middle = (low + high) / 2;
+        const std::uint8_t* entry = entries + middle * DatabaseFormat::OBJECT_ENTRY_SIZE;
+        int order = db->getString(readU32(entry)).compare(key);
+        if (order == 0) {
+            return DbValue(db, entry + 4);
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return DbValue();
+}
+
+GameDatabase::GameDatabase()
+    : bytes(nullptr), size(0), mapping(nullptr), rootCount(0), rootTable(0), stringCount(0), stringTable(0), stringData(0) {
+}
+
+GameDatabase::~GameDatabase() {
+    close();
+}
+
+bool GameDatabase::mapFile(const std::string& path) {
+#ifdef OPMON_HAVE_MMAP
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size <= 0) {
+        ::close(file);
+        return false;
+    }
+    
+    void* address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    
+    mapping = address;
+    bytes = static_cast<const std::uint8_t*>(address);
+    size = static_cast<std::size_t>(info.st_size);
+    return true;
+#else
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    if (buffer.empty()) {
+        return false;
+    }
+    bytes = buffer.data();
+    size = buffer.size();
+    return true;
+#endif
+}
+
+bool GameDatabase::open(const std::string& path) {
+    close();
+    
+    if (!mapFile(path)) {
+        std::cout << "Warning: could not open game database " << path << std::endl;
+        return false;
+    }
+    
+    std::string error;
+    if (!validate(error)) {
+        std::cout << "Warning: invalid game database " << path << ": " << error << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void GameDatabase::close() {
+#ifdef OPMON_HAVE_MMAP
+    if (mapping) {
+        munmap(mapping, size);
+    }
+#endif
+    mapping = nullptr;
+    buffer.clear();
+    bytes = nullptr;
+    size = 0;
+    rootCount = 0;
+    stringCount = 0;
+}
+
+bool GameDatabase::validateString(std::uint32_t index) const {
+    if (index >= stringCount) {
+        return false;
+    }
+    
+    const std::uint8_t* entry = bytes + stringTable + index * DatabaseFormat::STRING_ENTRY_SIZE;
+    std::uint64_t begin = static_cast<std::uint64_t>(stringData) + readU32(entry);
+    std::uint64_t end = begin + readU32(entry + 4);
+    return end < size && bytes[end] == 0;
+}
+
+bool GameDatabase::validateSlot(std::uint32_t offset, int depth, std::string& error) const {
+    if (depth > DatabaseFormat::MAX_DEPTH) {
+        error = "values nested too deeply";
+        return false;
+    }
+    
+    std::uint32_t type = readU32(bytes + offset);
+    std::uint32_t data = readU32(bytes + offset + 4);
+    switch (type) {
+        case DatabaseFormat::TYPE_NULL:
+        case DatabaseFormat::TYPE_BOOL:
+        case DatabaseFormat::TYPE_INT:
+            return true;
+        case DatabaseFormat::TYPE_INT64:
+        case DatabaseFormat::TYPE_DOUBLE:
+            if (static_cast<std::uint64_t>(data) + 8 > size) {
+                error = "number out of range";
+                return false;
+            }
+            return true;
+        case DatabaseFormat::TYPE_STRING:
+            if (!validateString(data)) {
+                error = "bad string reference";
+                return false;
+            }
+            return true;
+        case DatabaseFormat::TYPE_ARRAY:
+        case DatabaseFormat::TYPE_OBJECT: {
+            if (static_cast<std::uint64_t>(data) + 4 > size) {
+                error = "container out of range";
+                return false;
+            }
+            
+            std::uint64_t count = readU32(bytes + data);
+            std::uint64_t stride = type == DatabaseFormat::TYPE_ARRAY ? DatabaseFormat::SLOT_SIZE : DatabaseFormat::OBJECT_ENTRY_SIZE;
+            if (data + 4 + count * stride > size) {
+                error = "container out of range";
+                return false;
+            }
+            
+            for (std::uint64_t i = 0; i < count; ++i) {
+                std::uint32_t entry = static_cast<std::uint32_t>(data + 4 + i * stride);
+                if (type == DatabaseFormat::TYPE_OBJECT) {
+                    if (!validateString(readU32(bytes + entry))) {
+                        error = "bad object key";
+                        return false;
+                    }
+                    if (i > 0 && getString(readU32(bytes + entry - stride)) >= getString(readU32(bytes + entry))) {
+                        error = "object keys not sorted";
+                        return false;
+                    }
+                    entry += 4;
+                }
+                if (!validateSlot(entry, depth + 1, error)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            error = "unknown value type";
+            return false;
+    }
+}
+
+bool GameDatabase::validate(std::string& error) {
+    if (size < DatabaseFormat::HEADER_SIZE || std::memcmp(bytes, DatabaseFormat::MAGIC, sizeof(DatabaseFormat::MAGIC)) != 0) {
+        error = "not a game database";
+        return false;
+    }
+    
+    std::uint32_t version = readU32(bytes + DatabaseFormat::HEADER_VERSION);
+    if (version != DatabaseFormat::VERSION) {
+        error = "version " + std::to_string(version) + ", expected " + std::to_string(DatabaseFormat::VERSION);
+        return false;
+    }
+    
+    if (readU32(bytes + DatabaseFormat::HEADER_FILE_SIZE) != size) {
+        error = "truncated file";
+        return false;
+    }
+    
+    rootCount = readU32(bytes + DatabaseFormat::HEADER_ROOT_COUNT);
+    rootTable = readU32(bytes + DatabaseFormat::HEADER_ROOT_TABLE);
+    stringCount = readU32(bytes + DatabaseFormat::HEADER_STRING_COUNT);
+    stringTable = readU32(bytes + DatabaseFormat::HEADER_STRING_TABLE);
+    stringData = readU32(bytes + DatabaseFormat::HEADER_STRING_DATA);
+    
+    if (static_cast<std::uint64_t>(stringTable) + static_cast<std::uint64_t>(stringCount) * DatabaseFormat::STRING_ENTRY_SIZE > size
+        || stringData > size
+        || static_cast<std::uint64_t>(rootTable) + static_cast<std::uint64_t>(rootCount) * DatabaseFormat::ROOT_ENTRY_SIZE > size) {
+        error = "table out of range";
+        return false;
+    }
+    
+    for (std::uint32_t i = 0; i < stringCount; ++i) {
+        if (!validateString(i)) {
+            error = "bad string table";
+            return false;
+        }
+    }
+    
+    for (std::uint32_t i = 0; i < rootCount; ++i) {
+        std::uint32_t entry = rootTable + i * DatabaseFormat::ROOT_ENTRY_SIZE;
+        if (!validateString(readU32(bytes + entry))) {
+            error = "bad root name";
+            return false;
+        }
+        if (!validateSlot(entry + 4, 0, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DbValue GameDatabase::root(std::string_view name) const {
+    for (std::uint32_t i = 0; i < rootCount; ++i) {
+        const std::uint8_t* entry = bytes + rootTable + i * DatabaseFormat::ROOT_ENTRY_SIZE;
+        if (getString(readU32(entry)) == name) {
+            return DbValue(this, entry + 4);
+        }
+    }
+    return DbValue();
+}
+
+std::string_view GameDatabase::rootName(std::size_t index) const {
+    if (index >= rootCount) {
+        return std::string_view();
+    }
+    return getString(readU32(bytes + rootTable + index * DatabaseFormat::ROOT_ENTRY_SIZE));
+}
+
+std::string_view GameDatabase::getString(std::uint32_t index) const {
+    if (index >= stringCount) {
+        return std::string_view();
+    }
+    const std::uint8_t* entry = bytes + stringTable + index * DatabaseFormat::STRING_ENTRY_SIZE;
+    return std::string_view(reinterpret_cast<const char*>(bytes + stringData + readU32(entry)), readU32(entry + 4));
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include "DatabaseFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class GameDatabase;
+
+// Read-only view of one value in an open GameDatabase. Views are two
+// pointers, never allocate, and stay valid until the database is closed.
+// Lookups on a missing value or the wrong type return an empty view or the
+// fallback instead of failing.
+class DbValue {
+private:
+    const GameDatabase* db;
+    const std::uint8_t* slot;
+    
+    std::uint32_t data() const;
+    const std::uint8_t* payload() const;
+    
+    template<class Handler>
+    bool replayValue(Handler& handler, std::string& scratch) const;
+
+public:
+    DbValue() : db(nullptr), slot(nullptr) {}
+    DbValue(const GameDatabase* database, const std::uint8_t* valueSlot) : db(database), slot(valueSlot) {}
+    
+    bool isValid() const { return slot != nullptr; }
+    DatabaseFormat::ValueType getType() const;
+    bool isNull() const { return getType() == DatabaseFormat::TYPE_NULL; }
+    bool isBool() const { return getType() == DatabaseFormat::TYPE_BOOL; }
+    bool isNumber() const;
+    bool isString() const { return getType() == DatabaseFormat::TYPE_STRING; }
+    bool isArray() const { return getType() == DatabaseFormat::TYPE_ARRAY; }
+    bool isObject() const { return getType() == DatabaseFormat::TYPE_OBJECT; }
+    
+    bool asBool(bool fallback = false) const;
+    std::int64_t asInt(std::int64_t fallback = 0) const;
+    double asDouble(double fallback = 0) const;
+    // Points into the mapped file and is NUL-terminated
+    std::string_view asString(std::string_view fallback = std::string_view()) const;
+    
+    // Element count of an array or object, 0 otherwise
+    std::size_t size() const;
+    
+    // Array element or object value by position
+    DbValue at(std::size_t index) const;
+    std::string_view keyAt(std::size_t index) const;
+    
+    // Object member by key (binary search)
+    DbValue find(std::string_view key) const;
+    
+    // Replays this value as SAX events, like JsonTape::replay. Object
+    // members come out in key order rather than source order.
+    template<class Handler>
+    bool replay(Handler& handler) const;
+};
+
+// Memory-maps a database produced by opmon_dbc and serves DbValue views
+// into it. The whole file is validated once on open so views can read it
+// without bounds checks.
+class GameDatabase {
+private:
+    friend class DbValue;
+    
+    const std::uint8_t* bytes;
+    std::size_t size;
+    void* mapping;
+    std::vector<std::uint8_t> buffer; // Used when the platform cannot mmap
+    
+    std::uint32_t rootCount;
+    std::uint32_t rootTable;
+    std::uint32_t stringCount;
+    std::uint32_t stringTable;
+    std::uint32_t stringData;
+    
+    bool mapFile(const std::string& path);
+    bool validate(std::string& error);
+    bool validateSlot(std::uint32_t offset, int depth, std::string& error) const;
+    bool validateString(std::uint32_t index) const;
+
+public:
+    GameDatabase();
+    ~GameDatabase();
+    GameDatabase(const GameDatabase&) = delete;
+    GameDatabase& operator=(const GameDatabase&) = delete;
+    
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return bytes != nullptr; }
+    std::size_t getFileSize() const { return size; }
+    
+    // One root per compiled source file, e.g. "items" or "locations"
+    DbValue root(std::string_view name) const;
+    std::size_t getRootCount() const { return rootCount; }
+    std::string_view rootName(std::size_t index) const;
+    
+    std::string_view getString(std::uint32_t index) const;
+    std::size_t getStringCount() const { return stringCount; }
+};
+
+template<class Handler>
+bool DbValue::replay(Handler& handler) const {
+    std::string scratch;
+    return replayValue(handler, scratch);
+}
+
+template<class Handler>
+bool DbValue::replayValue(Handler& handler, std::string& scratch) const {
+    switch (getType()) {
+        case DatabaseFormat::TYPE_BOOL:
+            return handler.boolean(asBool());
+        case DatabaseFormat::TYPE_INT:
+        case DatabaseFormat::TYPE_INT64:
+            return handler.number_integer(asInt());
+        case DatabaseFormat::TYPE_DOUBLE:
+            // The source text is not kept in the database
+            scratch.clear();
+            return handler.number_float(asDouble(), scratch);
+        case DatabaseFormat::TYPE_STRING:
+            scratch.assign(asString());
+            return handler.string(scratch);
+        case DatabaseFormat::TYPE_ARRAY: {
+            std::size_t count = size();
+            if (!handler.start_array(count)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!at(i).replayValue(handler, scratch)) {
+                    return false;
+                }
+            }
+            return handler.end_array();
+        }
+        case DatabaseFormat::TYPE_OBJECT: {
+            std::size_t count = size();
+            if (!handler.start_object(count)) {
+                return false;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                scratch.assign(keyAt(i));
+                if (!handler.key(scratch) || !at(i).replayValue(handler, scratch)) {
+                    return false;
+                }
+            }
+            return handler.end_object();
+        }
+        default:
+            return handler.null();
+    }
+}
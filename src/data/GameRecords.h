@@ -0,0 +1,392 @@
+#pragma once
+#include "Reflection.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// Typed records for the files in assets/data. Identifiers are interned
+// StringIds, references to other records are Refs resolved by the link pass
+// in GameData, and display text is a view into the StringArena owned by
+// GameData.
+
+struct Character;
+struct Item;
+struct Location;
+struct Region;
+struct DialogueLine;
+
+// Number of entries in a character's baseStats ("0" to "8" in the data)
+const std::size_t BASE_STAT_COUNT = 9;
+
+// What each baseStats entry holds. Health is the large one (800-1500) and
+// only devil fruit users have DevilFruitPower, which pays ability powerCost.
+enum class Stat : std::uint8_t {
+    Stamina,
+    Health,
+    Attack,
+    Defense,
+    Speed,
+    Strength,
+    Agility,
+    DevilFruitPower,
+    Haki
+};
+
+// characters.json
+
+struct DevilFruitAbility {
+    std::string_view name;
+    std::string_view description;
+    int powerCost = 0;
+    int baseDamage = 0;
+    float cooldown = 0;
+    int levelRequirement = 0;
+};
+OPMON_REFLECT(DevilFruitAbility,
+    OPMON_FIELD(name),
+    OPMON_FIELD(description),
+    OPMON_FIELD(powerCost),
+    OPMON_FIELD(baseDamage),
+    OPMON_FIELD(cooldown),
+    OPMON_FIELD(levelRequirement))
+
+struct DevilFruit {
+    std::string_view name;
+    int type = 0;
+    std::string_view description;
+    int masteryLevel = 0;
+    bool awakened = false;
+    std::vector<DevilFruitAbility> abilities;
+};
+OPMON_REFLECT(DevilFruit,
+    OPMON_FIELD(name),
+    OPMON_FIELD(type),
+    OPMON_FIELD(description),
+    OPMON_FIELD(masteryLevel),
+    OPMON_FIELD(awakened),
+    OPMON_FIELD(abilities))
+
+struct RecruitmentRequirement {
+    StringId type;
+    Ref<Character> target; // Resolved to the enemy for "defeat" requirements
+    bool completed = false;
+};
+OPMON_REFLECT(RecruitmentRequirement,
+    OPMON_FIELD(type),
+    OPMON_FIELD(target),
+    OPMON_FIELD(completed))
+
+struct ItemDrop {
+    Ref<Item> item;
+    float chance = 0;
+};
+OPMON_REFLECT(ItemDrop,
+    OPMON_FIELD_AS("id", item),
+    OPMON_FIELD(chance))
+
+struct DropTable {
+    std::array<int, 2> berry = {}; // Min and max
+    std::vector<ItemDrop> items;
+};
+OPMON_REFLECT(DropTable,
+    OPMON_FIELD(berry),
+    OPMON_FIELD(items))
+
+struct Character {
+    StringId id;
+    std::string_view name;
+    std::string_view title;
+    int type = 0;
+    std::int64_t bounty = 0;
+    std::array<int, BASE_STAT_COUNT> baseStats = {};
+    std::optional<DevilFruit> devilFruit;
+    StringId recruitmentMethod;
+    bool isRecruited = false;
+    std::string_view role;
+    Ref<Location> joinLocation;
+    std::vector<RecruitmentRequirement> recruitmentRequirements;
+    std::optional<DropTable> dropTable; // Enemies only
+};
+OPMON_REFLECT(Character,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(title),
+    OPMON_FIELD(type),
+    OPMON_FIELD(bounty),
+    OPMON_FIELD(baseStats),
+    OPMON_FIELD(devilFruit),
+    OPMON_FIELD(recruitmentMethod),
+    OPMON_FIELD(isRecruited),
+    OPMON_FIELD(role),
+    OPMON_FIELD(joinLocation),
+    OPMON_FIELD(recruitmentRequirements),
+    OPMON_FIELD(dropTable))
+
+struct CharacterFile {
+    RecordMap<Character> characters;
+    RecordMap<Character> enemies;
+};
+OPMON_REFLECT(CharacterFile,
+    OPMON_FIELD(characters),
+    OPMON_FIELD(enemies))
+
+// items.json
+
+struct TemporaryStats {
+    int attack = 0;
+    int speed = 0;
+    float duration = 0;
+};
+OPMON_REFLECT(TemporaryStats,
+    OPMON_FIELD(attack),
+    OPMON_FIELD(speed),
+    OPMON_FIELD(duration))
+
+struct ItemEffects {
+    int heal = 0;
+    bool healFull = false;
+    int restoreStamina = 0;
+    int restoreDevilFruitPower = 0;
+    bool awakenDevilFruit = false;
+    std::optional<TemporaryStats> temporaryStats;
+};
+OPMON_REFLECT(ItemEffects,
+    OPMON_FIELD(heal),
+    OPMON_FIELD(healFull),
+    OPMON_FIELD(restoreStamina),
+    OPMON_FIELD(restoreDevilFruitPower),
+    OPMON_FIELD(awakenDevilFruit),
+    OPMON_FIELD(temporaryStats))
+
+struct Item {
+    StringId id;
+    std::string_view name;
+    std::string_view description;
+    int type = 0;
+    int rarity = 0;
+    int value = 0;
+    int stackSize = 1;
+    std::string_view iconTexture;
+    bool consumable = false;
+    bool keyItem = false;
+    StringId equipSlot;
+    ItemEffects effects;
+    RecordMap<int> statBonuses;
+    std::vector<StringId> specialEffects;
+};
+OPMON_REFLECT(Item,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(description),
+    OPMON_FIELD(type),
+    OPMON_FIELD(rarity),
+    OPMON_FIELD(value),
+    OPMON_FIELD(stackSize),
+    OPMON_FIELD(iconTexture),
+    OPMON_FIELD(consumable),
+    OPMON_FIELD(keyItem),
+    OPMON_FIELD(equipSlot),
+    OPMON_FIELD(effects),
+    OPMON_FIELD(statBonuses),
+    OPMON_FIELD(specialEffects))
+
+// Stat bonuses sit next to specialAbility in the data, so every other key
+// is collected into stats
+struct SetBonus {
+    std::string_view specialAbility;
+    RecordMap<int> stats;
+};
+OPMON_REFLECT_WITH_REST(SetBonus, stats,
+    OPMON_FIELD(specialAbility))
+
+struct ItemSet {
+    std::string_view name;
+    std::string_view description;
+    std::vector<Ref<Item>> items;
+    RecordMap<SetBonus> setBonuses; // Keyed by piece count, e.g. "2_piece"
+};
+OPMON_REFLECT(ItemSet,
+    OPMON_FIELD(name),
+    OPMON_FIELD(description),
+    OPMON_FIELD(items),
+    OPMON_FIELD(setBonuses))
+
+struct ItemFile {
+    RecordMap<RecordMap<Item>> items; // Keyed by category, then id
+    RecordMap<ItemSet> itemSets;
+    RecordMap<std::vector<Ref<Item>>> shopInventories;
+};
+OPMON_REFLECT(ItemFile,
+    OPMON_FIELD(items),
+    OPMON_FIELD_AS("item_sets", itemSets),
+    OPMON_FIELD_AS("shop_inventories", shopInventories))
+
+// locations.json
+
+struct LocationNpc {
+    StringId id;
+    std::string_view name;
+    std::array<float, 2> position = {};
+    std::string_view dialogue;
+    bool isSpirit = false;
+    bool isBoss = false;
+};
+OPMON_REFLECT(LocationNpc,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(position),
+    OPMON_FIELD(dialogue),
+    OPMON_FIELD(isSpirit),
+    OPMON_FIELD(isBoss))
+
+struct LocationShop {
+    StringId id;
+    std::string_view name;
+    std::string_view keeper;
+    std::array<float, 2> position = {};
+    std::vector<Ref<Item>> inventory;
+};
+OPMON_REFLECT(LocationShop,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(keeper),
+    OPMON_FIELD(position),
+    OPMON_FIELD(inventory))
+
+struct SpecialArea {
+    StringId id;
+    std::string_view name;
+    std::array<float, 2> position = {};
+    std::string_view description;
+    StringId requiredQuest;
+};
+OPMON_REFLECT(SpecialArea,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(position),
+    OPMON_FIELD(description),
+    OPMON_FIELD(requiredQuest))
+
+struct LocationBoss {
+    StringId id;
+    std::string_view name;
+    std::array<float, 2> position = {};
+    std::int64_t bounty = 0;
+    StringId questRequired;
+};
+OPMON_REFLECT(LocationBoss,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(position),
+    OPMON_FIELD(bounty),
+    OPMON_FIELD(questRequired))
+
+struct RandomEncounter {
+    std::vector<std::vector<Ref<Character>>> enemyGroups;
+    float encounterRate = 0;
+};
+OPMON_REFLECT(RandomEncounter,
+    OPMON_FIELD(enemyGroups),
+    OPMON_FIELD(encounterRate))
+
+struct Location {
+    StringId id;
+    std::string_view name;
+    std::string_view description;
+    Ref<Region> region;
+    StringId type;
+    bool unlocked = false;
+    std::vector<Ref<Location>> connectedLocations;
+    std::string_view backgroundTexture;
+    std::string_view musicTrack;
+    std::vector<StringId> weatherTypes;
+    std::vector<LocationNpc> npcs;
+    std::vector<LocationShop> shops;
+    std::vector<SpecialArea> specialAreas;
+    std::vector<LocationBoss> bosses;
+    std::vector<RandomEncounter> randomEncounters;
+};
+OPMON_REFLECT(Location,
+    OPMON_FIELD(id),
+    OPMON_FIELD(name),
+    OPMON_FIELD(description),
+    OPMON_FIELD(region),
+    OPMON_FIELD(type),
+    OPMON_FIELD(unlocked),
+    OPMON_FIELD(connectedLocations),
+    OPMON_FIELD(backgroundTexture),
+    OPMON_FIELD(musicTrack),
+    OPMON_FIELD(weatherTypes),
+    OPMON_FIELD(npcs),
+    OPMON_FIELD(shops),
+    OPMON_FIELD(specialAreas),
+    OPMON_FIELD(bosses),
+    OPMON_FIELD(randomEncounters))
+
+struct Region {
+    std::string_view name;
+    std::string_view description;
+    std::string_view color;
+};
+OPMON_REFLECT(Region,
+    OPMON_FIELD(name),
+    OPMON_FIELD(description),
+    OPMON_FIELD(color))
+
+struct LocationFile {
+    RecordMap<Location> locations;
+    RecordMap<Region> regions;
+};
+OPMON_REFLECT(LocationFile,
+    OPMON_FIELD(locations),
+    OPMON_FIELD(regions))
+
+// dialogue/characters.json
+
+// Lines of one conversation node, e.g. "first_meeting"
+using DialogueNode = std::vector<DialogueLine>;
+
+struct DialogueResponse {
+    std::string_view text;
+    StringId action;
+    StringId flag;
+    StringId quest;
+    int amount = 0;
+    Ref<DialogueNode> next; // A node of the same speaker
+};
+OPMON_REFLECT(DialogueResponse,
+    OPMON_FIELD(text),
+    OPMON_FIELD(action),
+    OPMON_FIELD(flag),
+    OPMON_FIELD(quest),
+    OPMON_FIELD(amount),
+    OPMON_FIELD(next))
+
+struct DialogueLine {
+    std::string_view text;
+    StringId emotion;
+    RecordMap<std::string_view> conditions; // e.g. flag: hungry, crew_size: >2
+    StringId action;
+    StringId flag;
+    Ref<Item> item;
+    int amount = 0;
+    std::vector<DialogueResponse> responses;
+};
+OPMON_REFLECT(DialogueLine,
+    OPMON_FIELD(text),
+    OPMON_FIELD(emotion),
+    OPMON_FIELD(conditions),
+    OPMON_FIELD(action),
+    OPMON_FIELD(flag),
+    OPMON_FIELD(item),
+    OPMON_FIELD(amount),
+    OPMON_FIELD(responses))
+
+struct DialogueFile {
+    RecordMap<RecordMap<DialogueNode>> dialogues; // Keyed by speaker, then node
+};
+OPMON_REFLECT(DialogueFile,
+    OPMON_FIELD(dialogues))
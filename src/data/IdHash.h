@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+// Hashing shared by the runtime interner and opmon_idgen, which builds the
+// minimal perfect hash over the shipped identifiers. Changing anything here
+// requires regenerating ShippedIdTable.h.
+
+// FNV-1a with a final avalanche so both halves of the result are usable
+inline std::uint64_t hashId(std::string_view text) {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+// Maps a 32-bit value onto [0, range) without a division
+inline std::uint32_t reduceRange(std::uint32_t value, std::uint32_t range) {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(value) * range) >> 32);
+}
+
+inline std::uint32_t perfectHashBucket(std::uint64_t hash, std::uint32_t bucketCount) {
+    return reduceRange(static_cast<std::uint32_t>(hash >> 32), bucketCount);
+}
+
+// Slot of a key whose bucket was displaced with seed
+inline std::uint32_t perfectHashSlot(std::uint64_t hash, std::uint32_t seed, std::uint32_t slotCount) {
+    std::uint64_t mixed = (hash ^ (seed * 0x9E3779B97F4A7C15ull)) * 0xD6E8FEB86659FD93ull;
+    return reduceRange(static_cast<std::uint32_t>(mixed >> 32), slotCount);
+}
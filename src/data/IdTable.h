@@ -0,0 +1,41 @@
+#pragma once
+#include "StringId.h"
+#include <cstddef>
+#include <vector>
+
+// Records indexed directly by StringId. Ids are dense, so a lookup is one
+// bounds check and one load, with no hashing.
+template<class T>
+class IdTable {
+private:
+    std::vector<const T*> records;
+    std::size_t count = 0;
+
+public:
+    // Returns false if id is invalid or already present
+    bool add(StringId id, const T& record) {
+        if (!id.isValid()) {
+            return false;
+        }
+        if (id.index >= records.size()) {
+            records.resize(id.index + 1, nullptr);
+        }
+        if (records[id.index]) {
+            return false;
+        }
+        records[id.index] = &record;
+        ++count;
+        return true;
+    }
+    
+    const T* find(StringId id) const {
+        return id.index < records.size() ? records[id.index] : nullptr;
+    }
+    
+    void clear() {
+        records.clear();
+        count = 0;
+    }
+    
+    std::size_t size() const { return count; }
+};
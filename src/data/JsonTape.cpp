@@ -0,0 +1,1078 @@
+#include "JsonTape.h"
+#include "BitOps.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPMON_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if OPMON_JSON_SSE2 && (defined(__GNUC__) || defined(__clang__))
+#define OPMON_JSON_AVX2 1
+#define OPMON_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#elif OPMON_JSON_SSE2 && defined(__AVX2__)
+#define OPMON_JSON_AVX2 1
+#define OPMON_TARGET_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+    const std::size_t BLOCK_SIZE = 64;
+    const std::uint32_t MAX_COUNT = 0xFFFFFF;
+    const std::uint64_t ESCAPED_STRING = 1ull << 48;
+    // Same nesting limit GameDatabase checks on compiled files; it also
+    // bounds the recursion in JsonTape::replay
+    const std::size_t MAX_DEPTH = 64;
+    
+    // Per-block character classes, one bit per byte
+    struct BlockMasks {
+        std::uint64_t quote;
+        std::uint64_t backslash;
+        std::uint64_t structural; // { } [ ] : ,
+        std::uint64_t whitespace;
+        std::uint64_t control;    // Bytes below 0x20
+        std::uint64_t nonAscii;   // Bytes from 0x80, which need UTF-8 validation
+    };
+    
+    // State carried from one block to the next
+    struct ScanState {
+        std::uint64_t prevEscaped = 0;
+        std::uint64_t prevInString = 0;
+        std::uint64_t prevScalar = 0;
+        std::uint64_t controlInString = 0;
+        std::size_t count = 0;
+        // Scalar UTF-8 validation: continuation bytes still expected, and
+        // the range allowed for the next one
+        std::uint32_t utf8Pending = 0;
+        std::uint8_t utf8Low = 0x80;
+        std::uint8_t utf8High = 0xBF;
+        bool invalidUtf8 = false;
+    };
+    
+    // Bit i of the result is the XOR of bits 0..i: toggles on every quote
+    inline std::uint64_t prefixXor(std::uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+    
+    void classifyScalar(const std::uint8_t* block, BlockMasks& masks) {
+        masks = BlockMasks();
+        for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+            std::uint64_t bit = 1ull << i;
+            std::uint8_t c = block[i];
+            if (c == '"') {
+                masks.quote |= bit;
+            } else if (c == '\\') {
+                masks.backslash |= bit;
+            } else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') {
+                masks.structural |= bit;
+            } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                masks.whitespace |= bit;
+            }
+            if (c < 0x20) {
+                masks.control |= bit;
+            }
+            if (c >= 0x80) {
+                masks.nonAscii |= bit;
+            }
+        }
+    }
+    
+    // Checks a block against the UTF-8 grammar one byte at a time,
+    // rejecting overlong forms, surrogates and code points past U+10FFFF.
+    // Only blocks with non-ASCII bytes (or a sequence carried in from the
+    // previous block) get here.
+    void validateUtf8Scalar(const std::uint8_t* block, ScanState& state) {
+        for (std::size_t i = 0; i < BLOCK_SIZE; ++i) {
+            std::uint8_t c = block[i];
+            if (state.utf8Pending > 0) {
+                if (c < state.utf8Low || c > state.utf8High) {
+                    state.invalidUtf8 = true;
+                    return;
+                }
+                state.utf8Low = 0x80;
+                state.utf8High = 0xBF;
+                --state.utf8Pending;
+            } else if (c < 0x80) {
+                continue;
+            } else if (c >= 0xC2 && c <= 0xDF) {
+                state.utf8Pending = 1;
+            } else if (c >= 0xE0 && c <= 0xEF) {
+                state.utf8Pending = 2;
+                if (c == 0xE0) {
+                    state.utf8Low = 0xA0;
+                } else if (c == 0xED) {
+                    state.utf8High = 0x9F;
+                }
+            } else if (c >= 0xF0 && c <= 0xF4) {
+                state.utf8Pending = 3;
+                if (c == 0xF0) {
+                    state.utf8Low = 0x90;
+                } else if (c == 0xF4) {
+                    state.utf8High = 0x8F;
+                }
+            } else {
+                state.invalidUtf8 = true;
+                return;
+            }
+        }
+    }
+
+#if OPMON_JSON_SSE2
+    void classifySSE2(const std::uint8_t* block, BlockMasks& masks) {
+        masks = BlockMasks();
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i openBrace = _mm_set1_epi8('{');
+        const __m128i closeBrace = _mm_set1_epi8('}');
+        const __m128i openBracket = _mm_set1_epi8('[');
+        const __m128i closeBracket = _mm_set1_epi8(']');
+        const __m128i colon = _mm_set1_epi8(':');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i carriageReturn = _mm_set1_epi8('\r');
+        const __m128i controlMax = _mm_set1_epi8(0x1F);
+        
+        for (int lane = 0; lane < 4; ++lane) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + lane * 16));
+            int shift = lane * 16;
+            
+            __m128i structural = _mm_or_si128(
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, openBrace), _mm_cmpeq_epi8(bytes, closeBrace)),
+                             _mm_or_si128(_mm_cmpeq_epi8(bytes, openBracket), _mm_cmpeq_epi8(bytes, closeBracket))),
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, colon), _mm_cmpeq_epi8(bytes, comma)));
+            __m128i whitespace = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, space), _mm_cmpeq_epi8(bytes, tab)),
+                _mm_or_si128(_mm_cmpeq_epi8(bytes, newline), _mm_cmpeq_epi8(bytes, carriageReturn)));
+            // Unsigned bytes <= 0x1F are the ones where max(byte, 0x1F) == 0x1F
+            __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(bytes, controlMax), controlMax);
+            
+            // SSE2 has no byte shuffle for the table lookups the AVX2 path
+            // uses, so non-ASCII blocks are validated by the scalar code
+            masks.nonAscii |= static_cast<std::uint64_t>(_mm_movemask_epi8(bytes) & 0xFFFF) << shift;
+            
+            masks.quote |= static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) & 0xFFFF) << shift;
+            masks.backslash |= static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, backslash)) & 0xFFFF) << shift;
+            masks.structural |= static_cast<std::uint64_t>(_mm_movemask_epi8(structural) & 0xFFFF) << shift;
+            masks.whitespace |= static_cast<std::uint64_t>(_mm_movemask_epi8(whitespace) & 0xFFFF) << shift;
+            masks.control |= static_cast<std::uint64_t>(_mm_movemask_epi8(control) & 0xFFFF) << shift;
+        }
+    }
+#endif
+
+#if OPMON_JSON_AVX2
+    OPMON_TARGET_AVX2
+    void classifyAVX2(const std::uint8_t* block, BlockMasks& masks) {
+        masks = BlockMasks();
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i openBrace = _mm256_set1_epi8('{');
+        const __m256i closeBrace = _mm256_set1_epi8('}');
+        const __m256i openBracket = _mm256_set1_epi8('[');
+        const __m256i closeBracket = _mm256_set1_epi8(']');
+        const __m256i colon = _mm256_set1_epi8(':');
+        const __m256i comma = _mm256_set1_epi8(',');
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+        const __m256i newline = _mm256_set1_epi8('\n');
+        const __m256i carriageReturn = _mm256_set1_epi8('\r');
+        const __m256i controlMax = _mm256_set1_epi8(0x1F);
+        
+        for (int lane = 0; lane < 2; ++lane) {
+            __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + lane * 32));
+            int shift = lane * 32;
+            
+            __m256i structural = _mm256_or_si256(
+                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, openBrace), _mm256_cmpeq_epi8(bytes, closeBrace)),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, openBracket), _mm256_cmpeq_epi8(bytes, closeBracket))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, colon), _mm256_cmpeq_epi8(bytes, comma)));
+            __m256i whitespace = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, space), _mm256_cmpeq_epi8(bytes, tab)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, newline), _mm256_cmpeq_epi8(bytes, carriageReturn)));
+            __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, controlMax), controlMax);
+            
+            masks.quote |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote)))) << shift;
+            masks.backslash |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, backslash)))) << shift;
+            masks.structural |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(structural))) << shift;
+            masks.whitespace |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace))) << shift;
+            masks.control |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(control))) << shift;
+            masks.nonAscii |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(bytes))) << shift;
+        }
+    }
+    
+    // UTF-8 validation after Keiser and Lemire, as in simdjson. Three
+    // nibble lookups flag every bad pair of adjacent bytes (a lead without
+    // continuation, a stray continuation, overlong forms, surrogates, code
+    // points past U+10FFFF); a saturating subtract then marks where the
+    // third and fourth bytes of long sequences must be continuations.
+    struct Utf8StateAVX2 {
+        __m256i error;
+        __m256i prevInput;
+        __m256i prevIncomplete; // Non-zero where the last block ended mid-sequence
+    };
+    
+    template<int N>
+    OPMON_TARGET_AVX2
+    inline __m256i previousBytesAVX2(__m256i input, __m256i prevInput) {
+        // input shifted right by N bytes, with the end of prevInput shifted in
+        return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prevInput, input, 0x21), 16 - N);
+    }
+    
+    OPMON_TARGET_AVX2
+    inline __m256i nibbleTableAVX2(std::uint8_t v0, std::uint8_t v1, std::uint8_t v2, std::uint8_t v3,
+                                   std::uint8_t v4, std::uint8_t v5, std::uint8_t v6, std::uint8_t v7,
+                                   std::uint8_t v8, std::uint8_t v9, std::uint8_t v10, std::uint8_t v11,
+                                   std::uint8_t v12, std::uint8_t v13, std::uint8_t v14, std::uint8_t v15) {
+        return _mm256_setr_epi8(
+            static_cast<char>(v0), static_cast<char>(v1), static_cast<char>(v2), static_cast<char>(v3),
+            static_cast<char>(v4), static_cast<char>(v5), static_cast<char>(v6), static_cast<char>(v7),
+            static_cast<char>(v8), static_cast<char>(v9), static_cast<char>(v10), static_cast<char>(v11),
+            static_cast<char>(v12), static_cast<char>(v13), static_cast<char>(v14), static_cast<char>(v15),
+            static_cast<char>(v0), static_cast<char>(v1), static_cast<char>(v2), static_cast<char>(v3),
+            static_cast<char>(v4), static_cast<char>(v5), static_cast<char>(v6), static_cast<char>(v7),
+            static_cast<char>(v8), static_cast<char>(v9), static_cast<char>(v10), static_cast<char>(v11),
+            static_cast<char>(v12), static_cast<char>(v13), static_cast<char>(v14), static_cast<char>(v15));
+    }
+    
+    OPMON_TARGET_AVX2
+    void validateUtf8AVX2(const std::uint8_t* block, Utf8StateAVX2& state) {
+        // Error bits for a byte pair; a pair is bad when all three lookups agree
+        const std::uint8_t TOO_SHORT = 1 << 0;      // Lead not followed by a continuation
+        const std::uint8_t TOO_LONG = 1 << 1;       // Continuation after ASCII
+        const std::uint8_t OVERLONG_3 = 1 << 2;     // E0 80..9F
+        const std::uint8_t TOO_LARGE = 1 << 3;      // F4 90..BF, F5..FF
+        const std::uint8_t SURROGATE = 1 << 4;      // ED A0..BF
+        const std::uint8_t OVERLONG_2 = 1 << 5;     // C0..C1
+        const std::uint8_t TOO_LARGE_1000 = 1 << 6; // F5..FF 80..8F
+        const std::uint8_t OVERLONG_4 = 1 << 6;     // F0 80..8F
+        const std::uint8_t TWO_CONTS = 1 << 7;      // Continuation after continuation
+        const std::uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+        
+        const __m256i byte1HighTable = nibbleTableAVX2(
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+        const __m256i byte1LowTable = nibbleTableAVX2(
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+            CARRY | OVERLONG_2,
+            CARRY,
+            CARRY,
+            CARRY | TOO_LARGE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000);
+        const __m256i byte2HighTable = nibbleTableAVX2(
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+        const __m256i lowNibble = _mm256_set1_epi8(0x0F);
+        // Anything above these in the last three bytes starts a sequence
+        // that runs into the next block
+        const __m256i incompleteMax = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xEF), static_cast<char>(0xDF), static_cast<char>(0xBF));
+        
+        for (int lane = 0; lane < 2; ++lane) {
+            __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + lane * 32));
+            if (_mm256_movemask_epi8(input) == 0) {
+                state.error = _mm256_or_si256(state.error, state.prevIncomplete);
+                state.prevInput = _mm256_setzero_si256();
+                state.prevIncomplete = _mm256_setzero_si256();
+                continue;
+            }
+            
+            __m256i prev1 = previousBytesAVX2<1>(input, state.prevInput);
+            __m256i byte1High = _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), lowNibble));
+            __m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, lowNibble));
+            __m256i byte2High = _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), lowNibble));
+            __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+            
+            // Bytes two after E0..FF and three after F0..FF must be continuations
+            __m256i prev2 = previousBytesAVX2<2>(input, state.prevInput);
+            __m256i prev3 = previousBytesAVX2<3>(input, state.prevInput);
+            __m256i thirdByte = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            __m256i fourthByte = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            __m256i mustContinue = _mm256_and_si256(_mm256_or_si256(thirdByte, fourthByte), _mm256_set1_epi8(static_cast<char>(0x80)));
+            
+            state.error = _mm256_or_si256(state.error, _mm256_xor_si256(mustContinue, special));
+            state.prevIncomplete = _mm256_subs_epu8(input, incompleteMax);
+            state.prevInput = input;
+        }
+    }
+#endif
+    
+    // Turns one block's character classes into structural offsets
+    inline void processBlock(const BlockMasks& masks, ScanState& state, std::uint32_t base, std::uint32_t* out) {
+        // A backslash escapes the next byte unless it is itself escaped;
+        // escapes are rare so they are resolved one at a time
+        std::uint64_t escaped = state.prevEscaped;
+        state.prevEscaped = 0;
+        std::uint64_t escapes = masks.backslash & ~escaped;
+        while (escapes) {
+            int bit = trailingZeros(escapes);
+            escapes &= escapes - 1;
+            if (bit == 63) {
+                state.prevEscaped = 1;
+            } else {
+                std::uint64_t next = 1ull << (bit + 1);
+                escaped |= next;
+                escapes &= ~next;
+            }
+        }
+        
+        // In-string bits cover the opening quote and the contents, not the closing quote
+        std::uint64_t quote = masks.quote & ~escaped;
+        std::uint64_t inString = prefixXor(quote) ^ state.prevInString;
+        state.prevInString = static_cast<std::uint64_t>(static_cast<std::int64_t>(inString) >> 63);
+        state.controlInString |= masks.control & inString;
+        
+        std::uint64_t outside = ~(inString | quote);
+        std::uint64_t structural = masks.structural & outside;
+        
+        // Literals and numbers are indexed by their first byte
+        std::uint64_t scalar = outside & ~masks.structural & ~masks.whitespace;
+        std::uint64_t scalarStart = scalar & ~((scalar << 1) | state.prevScalar);
+        state.prevScalar = scalar >> 63;
+        
+        std::uint64_t bits = structural | quote | scalarStart;
+        std::uint32_t* write = out + state.count;
+        while (bits) {
+            *write++ = base + static_cast<std::uint32_t>(trailingZeros(bits));
+            bits &= bits - 1;
+        }
+        state.count = static_cast<std::size_t>(write - out);
+    }
+    
+    // The final partial block is copied into a space-padded buffer so the
+    // classifiers never read past the end of the input
+    template<class Classify>
+    void scanBlocks(Classify classify, const std::uint8_t* bytes, std::size_t size, std::vector<std::uint32_t>& out, ScanState& state) {
+        BlockMasks masks;
+        std::size_t offset = 0;
+        for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+            if (state.count + BLOCK_SIZE > out.size()) {
+                out.resize(std::max(out.size() * 2, state.count + BLOCK_SIZE));
+            }
+            classify(bytes + offset, masks);
+            if ((masks.nonAscii || state.utf8Pending) && !state.invalidUtf8) {
+                validateUtf8Scalar(bytes + offset, state);
+            }
+            processBlock(masks, state, static_cast<std::uint32_t>(offset), out.data());
+        }
+        
+        // Padding with spaces also cuts off any unfinished UTF-8 sequence
+        if (offset < size) {
+            std::uint8_t tail[BLOCK_SIZE];
+            std::memset(tail, ' ', BLOCK_SIZE);
+            std::memcpy(tail, bytes + offset, size - offset);
+            if (state.count + BLOCK_SIZE > out.size()) {
+                out.resize(state.count + BLOCK_SIZE);
+            }
+            classify(tail, masks);
+            if ((masks.nonAscii || state.utf8Pending) && !state.invalidUtf8) {
+                validateUtf8Scalar(tail, state);
+            }
+            processBlock(masks, state, static_cast<std::uint32_t>(offset), out.data());
+        }
+        state.invalidUtf8 |= state.utf8Pending != 0;
+    }
+
+#if OPMON_JSON_AVX2
+    OPMON_TARGET_AVX2
+    void scanAVX2(const std::uint8_t* bytes, std::size_t size, std::vector<std::uint32_t>& out, ScanState& state) {
+        BlockMasks masks;
+        Utf8StateAVX2 utf8 = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+        std::size_t offset = 0;
+        for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+            if (state.count + BLOCK_SIZE > out.size()) {
+                out.resize(std::max(out.size() * 2, state.count + BLOCK_SIZE));
+            }
+            classifyAVX2(bytes + offset, masks);
+            validateUtf8AVX2(bytes + offset, utf8);
+            processBlock(masks, state, static_cast<std::uint32_t>(offset), out.data());
+        }
+        
+        if (offset < size) {
+            std::uint8_t tail[BLOCK_SIZE];
+            std::memset(tail, ' ', BLOCK_SIZE);
+            std::memcpy(tail, bytes + offset, size - offset);
+            if (state.count + BLOCK_SIZE > out.size()) {
+                out.resize(state.count + BLOCK_SIZE);
+            }
+            classifyAVX2(tail, masks);
+            validateUtf8AVX2(tail, utf8);
+            processBlock(masks, state, static_cast<std::uint32_t>(offset), out.data());
+        }
+        
+        __m256i error = _mm256_or_si256(utf8.error, utf8.prevIncomplete);
+        state.invalidUtf8 = !_mm256_testz_si256(error, error);
+    }
+#endif
+    
+    inline bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+    
+    // Bytes that may follow a number or literal
+    inline bool isTerminator(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' || c == '}' || c == ']' || c == ':' || c == '"'
+            || c == '{' || c == '[';
+    }
+    
+    int hexValue(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+    
+    bool readHex4(const char* text, const char* end, std::uint32_t& value) {
+        if (end - text < 4) {
+            return false;
+        }
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            int digit = hexValue(text[i]);
+            if (digit < 0) {
+                return false;
+            }
+            value = (value << 4) | static_cast<std::uint32_t>(digit);
+        }
+        return true;
+    }
+    
+    void appendUtf8(std::string& out, std::uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out.push_back(static_cast<char>(codePoint));
+        } else if (codePoint < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else if (codePoint < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+}
+
+std::uint8_t TapeValue::type() const {
+    return tape ? JsonTape::tagOf(tape->tape[index]) : static_cast<std::uint8_t>(JsonTape::TAPE_NULL);
+}
+
+bool TapeValue::isNull() const {
+    return type() == JsonTape::TAPE_NULL;
+}
+
+bool TapeValue::isBool() const {
+    return type() == JsonTape::TAPE_TRUE || type() == JsonTape::TAPE_FALSE;
+}
+
+bool TapeValue::isNumber() const {
+    return type() == JsonTape::TAPE_INT || type() == JsonTape::TAPE_DOUBLE;
+}
+
+bool TapeValue::isString() const {
+    return type() == JsonTape::TAPE_STRING;
+}
+
+bool TapeValue::isArray() const {
+    return type() == JsonTape::TAPE_ARRAY_START;
+}
+
+bool TapeValue::isObject() const {
+    return type() == JsonTape::TAPE_OBJECT_START;
+}
+
+bool TapeValue::asBool(bool fallback) const {
+    return isBool() ? type() == JsonTape::TAPE_TRUE : fallback;
+}
+
+std::int64_t TapeValue::asInt(std::int64_t fallback) const {
+    switch (type()) {
+        case JsonTape::TAPE_INT:
+            return static_cast<std::int64_t>(tape->tape[index + 1]);
+        case JsonTape::TAPE_DOUBLE:
+            return static_cast<std::int64_t>(tape->doubleAt(index));
+        default:
+            return fallback;
+    }
+}
+
+double TapeValue::asDouble(double fallback) const {
+    switch (type()) {
+        case JsonTape::TAPE_INT:
+            return static_cast<double>(static_cast<std::int64_t>(tape->tape[index + 1]));
+        case JsonTape::TAPE_DOUBLE:
+            return tape->doubleAt(index);
+        default:
+            return fallback;
+    }
+}
+
+std::string_view TapeValue::asString(std::string_view fallback) const {
+    return isString() ? tape->stringAt(index) : fallback;
+}
+
+std::size_t TapeValue::size() const {
+    if (!isArray() && !isObject()) {
+        return 0;
+    }
+    
+    std::uint64_t word = tape->tape[index];
+    std::size_t count = static_cast<std::size_t>(JsonTape::payloadOf(word) >> 32);
+    if (count < MAX_COUNT) {
+        return count;
+    }
+    
+    // The count saturated; walk the children instead
+    std::uint32_t end = static_cast<std::uint32_t>(word);
+    count = 0;
+    for (std::uint32_t child = index + 1; child < end; ++count) {
+        child = tape->skip(isObject() ? child + 2 : child);
+    }
+    return count;
+}
+
+TapeValue TapeValue::at(std::size_t position) const {
+    if (!isArray() && !isObject()) {
+        return TapeValue();
+    }
+    
+    bool object = isObject();
+    std::uint32_t end = static_cast<std::uint32_t>(tape->tape[index]);
+    std::uint32_t child = index + 1;
+    for (std::size_t i = 0; child < end; ++i) {
+        std::uint32_t value = object ? child + 2 : child;
+        if (i == position) {
+            return TapeValue(tape, value);
+        }
+        child = tape->skip(value);
+    }
+    return TapeValue();
+}
+
+std::string_view TapeValue::keyAt(std::size_t position) const {
+    if (!isObject()) {
+        return std::string_view();
+    }
+    
+    std::uint32_t end = static_cast<std::uint32_t>(tape->tape[index]);
+    std::uint32_t child = index + 1;
+    for (std::size_t i = 0; child < end; ++i) {
+        if (i == position) {
+            return tape->stringAt(child);
+        }
+        child = tape->skip(child + 2);
+    }
+    return std::string_view();
+}
+
+TapeValue TapeValue::find(std::string_view key) const {
+    if (!isObject()) {
+        return TapeValue();
+    }
+    
+    std::uint32_t end = static_cast<std::uint32_t>(tape->tape[index]);
+    for (std::uint32_t child = index + 1; child < end; child = tape->skip(child + 2)) {
+        if (tape->stringAt(child) == key) {
+            return TapeValue(tape, child + 2);
+        }
+    }
+    return TapeValue();
+}
+
+JsonTape::JsonTape(Backend preferred) : backend(preferred) {
+    // Fall back step by step until we reach something the CPU can run
+    while (!isSupported(backend)) {
+        backend = backend == Backend::AVX2 ? Backend::SSE2 : Backend::Scalar;
+    }
+}
+
+bool JsonTape::fail(const char* message, std::size_t offset) {
+    error = std::string(message) + " at offset " + std::to_string(offset);
+    tape.clear();
+    return false;
+}
+
+bool JsonTape::parse(std::string_view json) {
+    // A UTF-8 byte order mark is skipped, as nlohmann does
+    if (json.size() >= 3 && json.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        json.remove_prefix(3);
+    }
+    source = json;
+    error.clear();
+    tape.clear();
+    unescaped.clear();
+    
+    // Offsets are stored in 32 bits
+    if (json.size() >= 0xFFFFFFFFu) {
+        return fail("input too large", 0);
+    }
+    
+    return indexStructurals() && buildTape();
+}
+
+bool JsonTape::loadFromFile(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        error = "could not open " + path;
+        tape.clear();
+        return false;
+    }
+    
+    std::string contents((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    ownedSource.swap(contents);
+    return parse(ownedSource);
+}
+
+bool JsonTape::indexStructurals() {
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(source.data());
+    ScanState state;
+    
+    switch (backend) {
+#if OPMON_JSON_AVX2
+        case Backend::AVX2:
+            scanAVX2(bytes, source.size(), structurals, state);
+            break;
+#endif
+#if OPMON_JSON_SSE2
+        case Backend::SSE2:
+            scanBlocks(classifySSE2, bytes, source.size(), structurals, state);
+            break;
+#endif
+        default:
+            scanBlocks(classifyScalar, bytes, source.size(), structurals, state);
+            break;
+    }
+    
+    if (state.prevInString) {
+        return fail("unterminated string", source.size());
+    }
+    if (state.controlInString) {
+        return fail("unescaped control character in string", 0);
+    }
+    if (state.invalidUtf8) {
+        return fail("invalid UTF-8", 0);
+    }
+    
+    structurals.resize(state.count);
+    return true;
+}
+
+void JsonTape::closeContainer() {
+    OpenContainer open = stack.back();
+    stack.pop_back();
+    
+    std::uint32_t closeIndex = static_cast<std::uint32_t>(tape.size());
+    std::uint64_t count = std::min<std::uint32_t>(open.count, MAX_COUNT);
+    tape.push_back(makeWord(open.object ? TAPE_OBJECT_END : TAPE_ARRAY_END, open.tapeIndex));
+    tape[open.tapeIndex] = makeWord(open.object ? TAPE_OBJECT_START : TAPE_ARRAY_START, (count << 32) | closeIndex);
+}
+
+bool JsonTape::parseString(std::size_t structuralIndex) {
+    // The closing quote is always the next structural offset
+    if (structuralIndex + 1 >= structurals.size()) {
+        return fail("unterminated string", structurals[structuralIndex]);
+    }
+    
+    std::uint32_t begin = structurals[structuralIndex] + 1;
+    std::uint32_t end = structurals[structuralIndex + 1];
+    const char* text = source.data();
+    
+    if (!std::memchr(text + begin, '\\', end - begin)) {
+        tape.push_back(makeWord(TAPE_STRING, begin));
+        tape.push_back(end - begin);
+        return true;
+    }
+    
+    std::size_t offset = unescaped.size();
+    for (const char* p = text + begin; p < text + end; ++p) {
+        if (*p != '\\') {
+            unescaped.push_back(*p);
+            continue;
+        }
+        
+        ++p;
+        switch (*p) {
+            case '"': unescaped.push_back('"'); break;
+            case '\\': unescaped.push_back('\\'); break;
+            case '/': unescaped.push_back('/'); break;
+            case 'b': unescaped.push_back('\b'); break;
+            case 'f': unescaped.push_back('\f'); break;
+            case 'n': unescaped.push_back('\n'); break;
+            case 'r': unescaped.push_back('\r'); break;
+            case 't': unescaped.push_back('\t'); break;
+            case 'u': {
+                std::uint32_t codePoint;
+                if (!readHex4(p + 1, text + end, codePoint)) {
+                    return fail("invalid unicode escape", static_cast<std::size_t>(p - text));
+                }
+                p += 4;
+                
+                // Surrogate pairs combine into one code point
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    std::uint32_t low;
+                    if (p + 2 >= text + end || p[1] != '\\' || p[2] != 'u' || !readHex4(p + 3, text + end, low)
+                        || low < 0xDC00 || low > 0xDFFF) {
+                        return fail("invalid surrogate pair", static_cast<std::size_t>(p - text));
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    p += 6;
+                } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                    return fail("invalid surrogate pair", static_cast<std::size_t>(p - text));
+                }
+                appendUtf8(unescaped, codePoint);
+                break;
+            }
+            default:
+                return fail("invalid escape", static_cast<std::size_t>(p - text));
+        }
+    }
+    
+    std::size_t length = unescaped.size() - offset;
+    unescaped.push_back('\0');
+    tape.push_back(makeWord(TAPE_STRING, ESCAPED_STRING | offset));
+    tape.push_back(length);
+    return true;
+}
+
+bool JsonTape::parseNumber(std::uint32_t offset) {
+    const char* text = source.data();
+    const char* end = text + source.size();
+    const char* start = text + offset;
+    const char* p = start;
+    
+    bool negative = *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return fail("invalid value", offset);
+    }
+    
+    // Integer part; no leading zeros
+    std::uint64_t magnitude = 0;
+    bool overflow = false;
+    if (*p == '0') {
+        ++p;
+    } else {
+        for (; p < end && isDigit(*p); ++p) {
+            std::uint64_t digit = static_cast<std::uint64_t>(*p - '0');
+            overflow |= magnitude > (UINT64_MAX - digit) / 10;
+            magnitude = magnitude * 10 + digit;
+        }
+    }
+    
+    bool integer = true;
+    if (p < end && *p == '.') {
+        integer = false;
+        ++p;
+        if (p == end || !isDigit(*p)) {
+            return fail("invalid number", offset);
+        }
+        while (p < end && isDigit(*p)) {
+            ++p;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        integer = false;
+        ++p;
+        if (p < end && (*p == '+' || *p == '-')) {
+            ++p;
+        }
+        if (p == end || !isDigit(*p)) {
+            return fail("invalid number", offset);
+        }
+        while (p < end && isDigit(*p)) {
+            ++p;
+        }
+    }
+    if (p < end && !isTerminator(*p)) {
+        return fail("invalid number", offset);
+    }
+    
+    // Integers that fit in int64 stay exact; anything else becomes a double
+    std::uint64_t limit = negative ? (1ull << 63) : static_cast<std::uint64_t>(INT64_MAX);
+    if (integer && !overflow && magnitude <= limit) {
+        tape.push_back(makeWord(TAPE_INT, offset));
+        tape.push_back(negative ? 0 - magnitude : magnitude);
+        return true;
+    }
+    
+    double value = 0;
+    std::from_chars_result result = std::from_chars(start, p, value);
+    if (result.ec == std::errc::result_out_of_range) {
+        // Underflow rounds to zero; overflow is rejected like nlohmann does
+        value = std::strtod(std::string(start, p).c_str(), nullptr);
+        if (std::isinf(value)) {
+            return fail("number out of range", offset);
+        }
+    } else if (result.ec != std::errc()) {
+        return fail("invalid number", offset);
+    }
+    
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    tape.push_back(makeWord(TAPE_DOUBLE, offset));
+    tape.push_back(bits);
+    return true;
+}
+
+bool JsonTape::parseLiteral(std::uint32_t offset, const char* literal, std::size_t length, std::uint8_t tag) {
+    if (source.size() - offset < length || std::memcmp(source.data() + offset, literal, length) != 0
+        || (offset + length < source.size() && !isTerminator(source[offset + length]))) {
+        return fail("invalid literal", offset);
+    }
+    tape.push_back(makeWord(tag, 0));
+    return true;
+}
+
+bool JsonTape::buildTape() {
+    enum class State {
+        Value,
+        AfterValue,
+        Key
+    };
+    
+    const char* text = source.data();
+    const std::size_t count = structurals.size();
+    std::size_t i = 0;
+    State state = State::Value;
+    
+    stack.clear();
+    tape.reserve(count + count / 2 + 2);
+    tape.push_back(makeWord(TAPE_ROOT, 0));
+    
+    for (;;) {
+        switch (state) {
+            case State::Value: {
+                if (i >= count) {
+                    return fail("unexpected end of input", source.size());
+                }
+                
+                std::uint32_t offset = structurals[i];
+                switch (text[offset]) {
+                    case '{':
+                    case '[': {
+                        if (stack.size() >= MAX_DEPTH) {
+                            return fail("nesting too deep", offset);
+                        }
+                        bool object = text[offset] == '{';
+                        OpenContainer open = { static_cast<std::uint32_t>(tape.size()), 0, object };
+                        stack.push_back(open);
+                        tape.push_back(0);
+                        ++i;
+                        
+                        if (i < count && text[structurals[i]] == (object ? '}' : ']')) {
+                            closeContainer();
+                            ++i;
+                            state = State::AfterValue;
+                        } else {
+                            state = object ? State::Key : State::Value;
+                        }
+                        continue;
+                    }
+                    case '"':
+                        if (!parseString(i)) {
+                            return false;
+                        }
+                        i += 2;
+                        break;
+                    case 't':
+                        if (!parseLiteral(offset, "true", 4, TAPE_TRUE)) {
+                            return false;
+                        }
+                        ++i;
+                        break;
+                    case 'f':
+                        if (!parseLiteral(offset, "false", 5, TAPE_FALSE)) {
+                            return false;
+                        }
+                        ++i;
+                        break;
+                    case 'n':
+                        if (!parseLiteral(offset, "null", 4, TAPE_NULL)) {
+                            return false;
+                        }
+                        ++i;
+                        break;
+                    default:
+                        if (!parseNumber(offset)) {
+                            return false;
+                        }
+                        ++i;
+                        break;
+                }
+                state = State::AfterValue;
+                continue;
+            }
+            case State::AfterValue: {
+                if (stack.empty()) {
+                    if (i != count) {
+                        return fail("unexpected data after document", structurals[i]);
+                    }
+                    tape.push_back(makeWord(TAPE_ROOT, 0));
+                    tape[0] = makeWord(TAPE_ROOT, tape.size() - 1);
+                    return true;
+                }
+                if (i >= count) {
+                    return fail("unexpected end of input", source.size());
+                }
+                
+                OpenContainer& top = stack.back();
+                ++top.count;
+                char c = text[structurals[i]];
+                if (c == ',') {
+                    ++i;
+                    state = top.object ? State::Key : State::Value;
+                } else if (c == (top.object ? '}' : ']')) {
+                    closeContainer();
+                    ++i;
+                } else {
+                    return fail(top.object ? "expected ',' or '}'" : "expected ',' or ']'", structurals[i]);
+                }
+                continue;
+            }
+            case State::Key: {
+                if (i >= count || text[structurals[i]] != '"') {
+                    return fail("expected string key", i < count ? structurals[i] : source.size());
+                }
+                if (!parseString(i)) {
+                    return false;
+                }
+                i += 2;
+                
+                if (i >= count || text[structurals[i]] != ':') {
+                    return fail("expected ':'", i < count ? structurals[i] : source.size());
+                }
+                ++i;
+                state = State::Value;
+                continue;
+            }
+        }
+    }
+}
+
+TapeValue JsonTape::root() const {
+    return tape.size() >= 3 ? TapeValue(this, 1) : TapeValue();
+}
+
+std::uint32_t JsonTape::skip(std::uint32_t index) const {
+    std::uint64_t word = tape[index];
+    switch (tagOf(word)) {
+        case TAPE_OBJECT_START:
+        case TAPE_ARRAY_START:
+            return static_cast<std::uint32_t>(word) + 1;
+        case TAPE_STRING:
+        case TAPE_INT:
+        case TAPE_DOUBLE:
+            return index + 2;
+        default:
+            return index + 1;
+    }
+}
+
+std::string_view JsonTape::stringAt(std::uint32_t index) const {
+    std::uint64_t payload = payloadOf(tape[index]);
+    std::size_t length = static_cast<std::size_t>(tape[index + 1]);
+    std::size_t offset = static_cast<std::size_t>(payload & 0xFFFFFFFFu);
+    if (payload & ESCAPED_STRING) {
+        return std::string_view(unescaped.data() + offset, length);
+    }
+    return source.substr(offset, length);
+}
+
+std::string_view JsonTape::numberText(std::uint32_t index) const {
+    std::size_t begin = static_cast<std::size_t>(payloadOf(tape[index]));
+    std::size_t end = begin;
+    while (end < source.size() && !isTerminator(source[end])) {
+        ++end;
+    }
+    return source.substr(begin, end - begin);
+}
+
+double JsonTape::doubleAt(std::uint32_t index) const {
+    double value;
+    std::memcpy(&value, &tape[index + 1], sizeof(value));
+    return value;
+}
+
+JsonTape::Backend JsonTape::bestBackend() {
+    if (isSupported(Backend::AVX2)) {
+        return Backend::AVX2;
+    }
+    if (isSupported(Backend::SSE2)) {
+        return Backend::SSE2;
+    }
+    return Backend::Scalar;
+}
+
+bool JsonTape::isSupported(Backend candidate) {
+    switch (candidate) {
+        case Backend::Scalar:
+            return true;
+        case Backend::SSE2:
+#if OPMON_JSON_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case Backend::AVX2:
+#if OPMON_JSON_AVX2 && (defined(__GNUC__) || defined(__clang__))
+            return __builtin_cpu_supports("avx2");
+#elif OPMON_JSON_AVX2
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* JsonTape::backendName(Backend candidate) {
+    switch (candidate) {
+        case Backend::Scalar: return "scalar";
+        case Backend::SSE2: return "sse2";
+        case Backend::AVX2: return "avx2";
+    }
+    return "unknown";
+}
@@ -0,0 +1,218 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class JsonTape;
+
+// Navigable view of one value on a JsonTape. It offers the same accessors as
+// DbValue, so a loader can read either the compiled database or raw JSON.
+// Views stay valid until the tape is parsed again or destroyed.
+class TapeValue {
+private:
+    const JsonTape* tape;
+    std::uint32_t index;
+    
+    std::uint8_t type() const;
+
+public:
+    TapeValue() : tape(nullptr), index(0) {}
+    TapeValue(const JsonTape* owner, std::uint32_t tapeIndex) : tape(owner), index(tapeIndex) {}
+    
+    bool isValid() const { return tape != nullptr; }
+    bool isNull() const;
+    bool isBool() const;
+    bool isNumber() const;
+    bool isString() const;
+    bool isArray() const;
+    bool isObject() const;
+    
+    bool asBool(bool fallback = false) const;
+    std::int64_t asInt(std::int64_t fallback = 0) const;
+    double asDouble(double fallback = 0) const;
+    // Points into the source buffer unless the string contained escapes
+    std::string_view asString(std::string_view fallback = std::string_view()) const;
+    
+    // Element count of an array or object, 0 otherwise
+    std::size_t size() const;
+    
+    // Array element or object value by position (linear walk)
+    TapeValue at(std::size_t position) const;
+    std::string_view keyAt(std::size_t position) const;
+    
+    // Object member by key (linear walk; members keep their source order)
+    TapeValue find(std::string_view key) const;
+};
+
+// Two-stage JSON parser in the style of simdjson, for development builds
+// that load assets/data directly instead of game.db.
+//
+// Stage 1 classifies 64-byte blocks with SIMD compares to find quotes,
+// backslashes, structural characters and whitespace. It then derives
+// in-string masks with a prefix XOR and records the offset of every
+// structural character, quote and scalar start. The same pass checks that
+// the input is valid UTF-8: with simdjson's nibble lookups on AVX2, and
+// byte by byte for the (rare) non-ASCII blocks otherwise.
+//
+// Stage 2 walks those offsets once. It validates the grammar and writes a
+// flat tape of 64-bit words: containers point at their matching end,
+// strings reference the source buffer, and numbers are decoded. Documents
+// nested deeper than 64 levels are rejected, like in game.db.
+class JsonTape {
+public:
+    enum class Backend {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+    
+    // Tape word tags (top 8 bits of each word)
+    enum : std::uint8_t {
+        TAPE_ROOT = 'r',
+        TAPE_OBJECT_START = '{',
+        TAPE_OBJECT_END = '}',
+        TAPE_ARRAY_START = '[',
+        TAPE_ARRAY_END = ']',
+        TAPE_STRING = '"',  // Followed by a word holding the length
+        TAPE_INT = 'l',     // Followed by a word holding the value
+        TAPE_DOUBLE = 'd',  // Followed by a word holding the value's bits
+        TAPE_TRUE = 't',
+        TAPE_FALSE = 'f',
+        TAPE_NULL = 'n'
+    };
+
+private:
+    friend class TapeValue;
+    
+    struct OpenContainer {
+        std::uint32_t tapeIndex;
+        std::uint32_t count;
+        bool object;
+    };
+    
+    Backend backend;
+    std::string ownedSource;
+    std::string_view source;
+    std::vector<std::uint32_t> structurals;
+    std::vector<std::uint64_t> tape;
+    std::vector<OpenContainer> stack;
+    std::string unescaped; // Strings that contained escape sequences, NUL-separated
+    std::string error;
+    
+    static std::uint8_t tagOf(std::uint64_t word) { return static_cast<std::uint8_t>(word >> 56); }
+    static std::uint64_t payloadOf(std::uint64_t word) { return word & 0x00FFFFFFFFFFFFFFull; }
+    static std::uint64_t makeWord(std::uint8_t tag, std::uint64_t payload) { return (static_cast<std::uint64_t>(tag) << 56) | payload; }
+    
+    bool fail(const char* message, std::size_t offset);
+    bool indexStructurals();
+    bool buildTape();
+    bool parseString(std::size_t structuralIndex);
+    bool parseNumber(std::uint32_t offset);
+    bool parseLiteral(std::uint32_t offset, const char* literal, std::size_t length, std::uint8_t tag);
+    void closeContainer();
+    
+    std::uint32_t skip(std::uint32_t index) const;
+    std::string_view stringAt(std::uint32_t index) const;
+    std::string_view numberText(std::uint32_t index) const;
+    double doubleAt(std::uint32_t index) const;
+    
+    template<class Handler>
+    bool replayValue(Handler& handler, std::uint32_t& index, std::string& scratch) const;
+
+public:
+    explicit JsonTape(Backend preferred = bestBackend());
+    
+    // The tape points into json, which must outlive it (or the next parse)
+    bool parse(std::string_view json);
+    // Reads the file into a buffer owned by the tape, then parses it
+    bool loadFromFile(const std::string& path);
+    
+    const std::string& getError() const { return error; }
+    TapeValue root() const;
+    std::size_t getTapeSize() const { return tape.size(); }
+    std::size_t getStructuralCount() const { return structurals.size(); }
+    Backend getBackend() const { return backend; }
+    
+    // Replays the parsed document as SAX events. Handler follows the
+    // nlohmann::json_sax interface, so anything written for
+    // nlohmann::json::sax_parse (including typed deserializers and the DOM
+    // builder) can consume a tape without reparsing.
+    template<class Handler>
+    bool replay(Handler& handler) const;
+    
+    static Backend bestBackend();
+    static bool isSupported(Backend candidate);
+    static const char* backendName(Backend candidate);
+};
+
+template<class Handler>
+bool JsonTape::replay(Handler& handler) const {
+    if (tape.size() < 3) {
+        return false;
+    }
+    
+    std::string scratch;
+    std::uint32_t index = 1;
+    return replayValue(handler, index, scratch);
+}
+
+template<class Handler>
+bool JsonTape::replayValue(Handler& handler, std::uint32_t& index, std::string& scratch) const {
+    std::uint64_t word = tape[index];
+    switch (tagOf(word)) {
+        case TAPE_OBJECT_START:
+        case TAPE_ARRAY_START: {
+            bool object = tagOf(word) == TAPE_OBJECT_START;
+            std::uint32_t end = static_cast<std::uint32_t>(word);
+            std::size_t count = static_cast<std::size_t>(payloadOf(word) >> 32);
+            if (count == 0xFFFFFF) {
+                count = static_cast<std::size_t>(-1);
+            }
+            
+            if (!(object ? handler.start_object(count) : handler.start_array(count))) {
+                return false;
+            }
+            
+            ++index;
+            while (index < end) {
+                if (object) {
+                    scratch.assign(stringAt(index));
+                    index += 2;
+                    if (!handler.key(scratch)) {
+                        return false;
+                    }
+                }
+                if (!replayValue(handler, index, scratch)) {
+                    return false;
+                }
+            }
+            index = end + 1;
+            return object ? handler.end_object() : handler.end_array();
+        }
+        case TAPE_STRING:
+            scratch.assign(stringAt(index));
+            index += 2;
+            return handler.string(scratch);
+        case TAPE_INT: {
+            std::int64_t value = static_cast<std::int64_t>(tape[index + 1]);
+            index += 2;
+            return handler.number_integer(value);
+        }
+        case TAPE_DOUBLE: {
+            double value = doubleAt(index);
+            scratch.assign(numberText(index));
+            index += 2;
+            return handler.number_float(value, scratch);
+        }
+        case TAPE_TRUE:
+        case TAPE_FALSE:
+            ++index;
+            return handler.boolean(tagOf(word) == TAPE_TRUE);
+        default:
+            ++index;
+            return handler.null();
+    }
+}
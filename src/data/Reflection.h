@@ -0,0 +1,312 @@
+#pragma once
+#include "StringArena.h"
+#include "StringId.h"
+#include "StringInterner.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Field tables for data records. Each reflected type gets a static TypeInfo
+// describing how to store JSON values into it; StructReader walks those
+// tables while consuming SAX events, so records are filled in one pass
+// without an intermediate DOM.
+//
+// Declare a record's fields right after the struct:
+//
+//     struct Region {
+//         std::string_view name;
+//         std::string_view color;
+//     };
+//     OPMON_REFLECT(Region,
+//         OPMON_FIELD(name),
+//         OPMON_FIELD(color))
+//
+// Supported member types are bool, integers, enums, floating point,
+// std::string_view (stored in a StringArena), StringId (interned), Ref,
+// std::vector, std::array, std::optional, RecordMap and other reflected
+// structs.
+
+// JSON object read into a list of (key, value) pairs in source order
+template<class T>
+using RecordMap = std::vector<std::pair<StringId, T>>;
+
+// Identifier referencing another record. The reader only fills id; the
+// link pass in GameData points target at the record, or leaves it null and
+// reports the reference as dangling.
+template<class T>
+struct Ref {
+    StringId id;
+    const T* target = nullptr;
+    
+    const T* get() const { return target; }
+    const T* operator->() const { return target; }
+    const T& operator*() const { return *target; }
+    explicit operator bool() const { return target != nullptr; }
+};
+
+// Where the strings of a record being read end up
+struct ReadContext {
+    StringArena& text;
+    StringInterner& ids;
+};
+
+enum class TypeKind {
+    Bool,
+    Int,
+    Float,
+    String,
+    Id,
+    Struct,
+    Array,  // std::vector, or std::array when capacity is non-zero
+    Map,    // RecordMap
+    Optional
+};
+
+struct TypeInfo;
+
+struct FieldInfo {
+    std::string_view name;
+    const TypeInfo* type;
+    void* (*access)(void* object);
+};
+
+struct TypeInfo {
+    TypeKind kind;
+    const char* name;
+    
+    // Scalars
+    void (*setBool)(void* target, bool value);
+    void (*setInt)(void* target, std::int64_t value);
+    void (*setFloat)(void* target, double value);
+    void (*setString)(void* target, std::string_view value, ReadContext& context);
+    
+    // Structs. restField, when set, receives every unknown key
+    const FieldInfo* fields;
+    std::size_t fieldCount;
+    const FieldInfo* restField;
+    
+    // Containers. add appends an element (Array, Map) or engages the
+    // optional; elementAt indexes fixed-size arrays and returns nullptr when
+    // out of range
+    const TypeInfo* element;
+    std::size_t capacity;
+    void* (*add)(void* container, std::string_view key, ReadContext& context);
+    void* (*elementAt)(void* container, std::size_t index);
+    void (*reset)(void* container);
+    
+    const FieldInfo* findField(std::string_view key) const {
+        for (std::size_t i = 0; i < fieldCount; ++i) {
+            if (fields[i].name == key) {
+                return &fields[i];
+            }
+        }
+        return restField;
+    }
+};
+
+template<class T, class Enable = void>
+struct TypeOf;
+
+template<class T>
+const TypeInfo& typeOf() {
+    return TypeOf<T>::get();
+}
+
+inline TypeInfo makeScalarInfo(TypeKind kind, const char* name) {
+    TypeInfo info = {};
+    info.kind = kind;
+    info.name = name;
+    return info;
+}
+
+inline TypeInfo makeContainerInfo(TypeKind kind, const char* name, const TypeInfo& element, std::size_t capacity) {
+    TypeInfo info = makeScalarInfo(kind, name);
+    info.element = &element;
+    info.capacity = capacity;
+    return info;
+}
+
+template<>
+struct TypeOf<bool> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeScalarInfo(TypeKind::Bool, "bool");
+            info.setBool = [](void* target, bool value) { *static_cast<bool*>(target) = value; };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<class T>
+struct TypeOf<T, std::enable_if_t<(std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeScalarInfo(TypeKind::Int, "integer");
+            info.setInt = [](void* target, std::int64_t value) { *static_cast<T*>(target) = static_cast<T>(value); };
+            info.setFloat = [](void* target, double value) { *static_cast<T*>(target) = static_cast<T>(static_cast<std::int64_t>(value)); };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<class T>
+struct TypeOf<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeScalarInfo(TypeKind::Float, "number");
+            info.setInt = [](void* target, std::int64_t value) { *static_cast<T*>(target) = static_cast<T>(value); };
+            info.setFloat = [](void* target, double value) { *static_cast<T*>(target) = static_cast<T>(value); };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<>
+struct TypeOf<std::string_view> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeScalarInfo(TypeKind::String, "string");
+            info.setString = [](void* target, std::string_view value, ReadContext& context) {
+                *static_cast<std::string_view*>(target) = context.text.store(value);
+            };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<>
+struct TypeOf<StringId> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeScalarInfo(TypeKind::Id, "identifier");
+            info.setString = [](void* target, std::string_view value, ReadContext& context) {
+                *static_cast<StringId*>(target) = context.ids.intern(value);
+            };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<class T>
+struct TypeOf<Ref<T>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeScalarInfo(TypeKind::Id, "identifier");
+            info.setString = [](void* target, std::string_view value, ReadContext& context) {
+                static_cast<Ref<T>*>(target)->id = context.ids.intern(value);
+            };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<class T>
+struct TypeOf<std::vector<T>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeContainerInfo(TypeKind::Array, "array", typeOf<T>(), 0);
+            info.add = [](void* container, std::string_view, ReadContext&) -> void* {
+                return &static_cast<std::vector<T>*>(container)->emplace_back();
+            };
+            info.reset = [](void* container) { static_cast<std::vector<T>*>(container)->clear(); };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<class T>
+struct TypeOf<RecordMap<T>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeContainerInfo(TypeKind::Map, "object", typeOf<T>(), 0);
+            info.add = [](void* container, std::string_view key, ReadContext& context) -> void* {
+                return &static_cast<RecordMap<T>*>(container)->emplace_back(context.ids.intern(key), T()).second;
+            };
+            info.reset = [](void* container) { static_cast<RecordMap<T>*>(container)->clear(); };
+            return info;
+        }();
+        return info;
+    }
+};
+
+// Fixed-size arrays also accept objects keyed by index ("0", "1", ...)
+template<class T, std::size_t N>
+struct TypeOf<std::array<T, N>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeContainerInfo(TypeKind::Array, "array", typeOf<T>(), N);
+            info.elementAt = [](void* container, std::size_t index) -> void* {
+                return index < N ? &(*static_cast<std::array<T, N>*>(container))[index] : nullptr;
+            };
+            return info;
+        }();
+        return info;
+    }
+};
+
+// JSON null resets the optional; any other value engages it
+template<class T>
+struct TypeOf<std::optional<T>> {
+    static const TypeInfo& get() {
+        static const TypeInfo info = [] {
+            TypeInfo info = makeContainerInfo(TypeKind::Optional, typeOf<T>().name, typeOf<T>(), 0);
+            info.add = [](void* container, std::string_view, ReadContext&) -> void* {
+                return &static_cast<std::optional<T>*>(container)->emplace();
+            };
+            info.reset = [](void* container) { static_cast<std::optional<T>*>(container)->reset(); };
+            return info;
+        }();
+        return info;
+    }
+};
+
+template<class Owner, auto Member>
+FieldInfo makeField(std::string_view key) {
+    using Value = std::remove_reference_t<decltype(std::declval<Owner&>().*Member)>;
+    return { key, &typeOf<Value>(), [](void* object) -> void* { return &(static_cast<Owner*>(object)->*Member); } };
+}
+
+inline TypeInfo makeStructInfo(const char* name, const FieldInfo* fields, std::size_t fieldCount, const FieldInfo* restField) {
+    TypeInfo info = makeScalarInfo(TypeKind::Struct, name);
+    info.fields = fields;
+    info.fieldCount = fieldCount;
+    info.restField = restField;
+    return info;
+}
+
+#define OPMON_REFLECT_IMPL(Type, Rest, ...) \
+    template<> \
+    struct TypeOf<Type> { \
+        static const TypeInfo& get() { \
+            using Self = Type; \
+            static const FieldInfo fields[] = { __VA_ARGS__ }; \
+            static const TypeInfo info = makeStructInfo(#Type, fields, sizeof(fields) / sizeof(fields[0]), Rest); \
+            return info; \
+        } \
+    };
+
+#define OPMON_REFLECT(Type, ...) OPMON_REFLECT_IMPL(Type, nullptr, __VA_ARGS__)
+
+// Like OPMON_REFLECT, but keys matching no field are stored in the RecordMap member
+#define OPMON_REFLECT_WITH_REST(Type, RestMember, ...) \
+    OPMON_REFLECT_IMPL(Type, ([] { \
+        using Self = Type; \
+        static const FieldInfo rest = makeField<Self, &Self::RestMember>(#RestMember); \
+        return &rest; \
+    }()), __VA_ARGS__)
+
+#define OPMON_FIELD(member) makeField<Self, &Self::member>(#member)
+// For JSON keys that are not valid member names
+#define OPMON_FIELD_AS(key, member) makeField<Self, &Self::member>(key)
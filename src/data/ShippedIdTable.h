@@ -0,0 +1,352 @@
+#pragma once
+// Generated by opmon_idgen from assets/data. Do not edit; build the update_ids target instead.
+#include "ShippedIds.h"
+#include <cstdint>
+
+namespace {
+    const std::uint32_t SHIPPED_BUCKET_COUNT = 66;
+    
+    const std::uint32_t SHIPPED_BUCKET_SEEDS[SHIPPED_BUCKET_COUNT] = {
+        84, 0, 10, 26, 3, 1, 1, 195, 275, 34, 12, 0,
+        1, 3, 2, 15, 5, 0, 216, 214, 13, 211, 53, 0,
+        1, 0, 604, 2, 34, 137, 1474, 1, 0, 115, 52, 18,
+        7, 1837, 105, 4, 0, 15, 82, 249, 15, 3, 414, 532,
+        6, 235, 4218, 45, 177, 11, 27, 13, 153, 110, 13, 243,
+        2, 1920, 3307, 2, 386, 4865
+    };
+    
+    // Full hash of the identifier in each slot, compared instead of the string
+    const std::uint64_t SHIPPED_SLOT_HASHES[SHIPPED_ID_COUNT] = {
+        0x4511ca7bb1213f8bull, 0xc6b8ba0aa9c1ef7eull, 0x2a61af504e75ba9bull, 0xac8937c9abfd3ca7ull,
+        0x5702bfd55959d88aull, 0xffef4474df5b28eaull, 0x16bc5a96ae7fcc2full, 0xa2d840b9f7be68ddull,
+        0x9fb017cc1de93f4cull, 0x4975873e3e2e3d4aull, 0xacb2d3b5f316bf03ull, 0x864d32c9146b6d08ull,
+        0x15ad286aa0b28cbdull, 0x41f9551cb602ec31ull, 0x14dd2a4c2f85097eull, 0x9ea951dce4f790cull,
+        0xdd719ce5a519d747ull, 0x5fe9a0d1f4e0ffaeull, 0x14a6e768b1c36c14ull, 0x82ae35ae31674e6aull,
+        0x27691fdc2d12fe9full, 0x8720c15b8e8978acull, 0xafeca01069edc33eull, 0x555137b16d18fd15ull,
+        0xc701098ff039fd6full, 0xca4422bb7131dbfdull, 0x23eff0160e274ae0ull, 0x77c135b9b8ba7c44ull,
+        0x34721a12b77875f3ull, 0x26ba202accd4475aull, 0xd15051eb821ca301ull, 0xf79f63f55e533061ull,
+        0xba15b9d463ab2f67ull, 0x970c2a0309dc171cull, 0xc59888d9cace591ull, 0x5be2348dd37ba7eull,
+        0xe017a9b89092eff2ull, 0x1f3da422fbe4851aull, 0x31bdac4df68e5945ull, 0xf87b12e150e4b94cull,
+        0x4d536b0a60f9acd4ull, 0xeb785376fbabc4a2ull, 0x2bd33559ed307c45ull, 0xe974015db3e61f9eull,
+        0x5738b1197a9ffb0dull, 0xe7d3f53ea784c93full, 0x841b4d26d94b2191ull, 0xce93a3fd9984112dull,
+        0x5b7b9375a6aba77dull, 0x38fbba7683e0216eull, 0x357cecf875a68a17ull, 0xd6d1038b25c62523ull,
+        0xf62820232ebea5edull, 0x71ed30d95186828aull, 0xcc86f6b06c21c307ull, 0x5e824ea0301cf095ull,
+        0xa804b088304442a4ull, 0xc8fc43aa0ce5def7ull, 0xeff5c92328105389ull, 0xeda6893e002ddbbull,
+        0xcfe96ba166af46eeull, 0x5fb319ff6c9c94b4ull, 0x3c3c7ca5a1ce2cb7ull, 0xe7e910dbb3247b38ull,
+        0x632949c81b6303f0ull, 0x1b35dbe0e22edbecull, 0x7b32bec30f108424ull, 0xfadda0f0095fe25cull,
+        0xf0094686248d051full, 0x2cdc44b59d422212ull, 0x28253561ba1f7073ull, 0x3a1d5aa2def32847ull,
+        0x34bfac92d6ebb3e5ull, 0x1a048508002f1008ull, 0x54757acc34c0e028ull, 0x2e2c5091f9b080c6ull,
+        0xed4c8fcd1407f6deull, 0x260d9ee61af865efull, 0x620117a776a8d71dull, 0x4eb206a5b39f6c8aull,
+        0xb08426e370660d62ull, 0xb0b329757df3250bull, 0x344ee8113c8a94d5ull, 0xa731966d7ad686f5ull,
+        0x8ce012d4343b42aeull, 0x28cef5dd94a5d9b0ull, 0x2c061f2a08d1a211ull, 0xdae35ef1abf34217ull,
+        0xfb65f1011630f1c6ull, 0xac53a776d015f0c5ull, 0xf8a63ee6fa33d50ull, 0xd41e195352bbdbacull,
+        0x45372f2f61d84a9dull, 0x6b69d6a7c0424ccbull, 0x65d23a08a844bfcaull, 0x4558bf7d41d17816ull,
+        0x43e2e966126177e3ull, 0x9402388510ac8164ull, 0x8f3512b7a2ec9bb5ull, 0x9863fb7afbd28393ull,
+        0x6f8d0b9ebed11654ull, 0xe0b58f2b2ada2e0aull, 0x99ad85e4fade4788ull, 0xd793ea9074e31768ull,
+        0xc2d27b0f48376dfdull, 0xafe55c3f2a599680ull, 0xea26287f736ed7e4ull, 0x7306523c61c43a7eull,
+        0x5829909481b92cf4ull, 0x79cb104a8545b5e7ull, 0xf875ac654ee413d1ull, 0x5cb375a509c93c63ull,
+        0x1e706e3306a6658full, 0x95d2101780391d0dull, 0x12c47a8303dd2d4ull, 0x493efea5bc0d7a36ull,
+        0x79ecb287f4011b1eull, 0xa045050404a897abull, 0x605487a06bd1f539ull, 0xe2317920509f15c1ull,
+        0x1508d14cc7c0d7a5ull, 0xe599a33c90dbad3dull, 0x949bcba704afd8dbull, 0x457a358d64d9ffd4ull,
+        0x645597d02e1c1aedull, 0x3239d0c139ad1e44ull, 0x438f019aeed98cf5ull, 0xc7db477ec951e859ull,
+        0x9b2277d61d61209cull, 0x4bef1287bc1a19bull, 0x83873e8559ec5a8eull, 0xd0fe007a2c3f64a5ull,
+        0x97d3e5392568354ull, 0xbb26c96ef73a7548ull, 0x5e52d7ca74220d8ull, 0x2788962b9c88c603ull,
+        0xbcb4306962cd71aaull, 0x6991e38d6549e0a2ull, 0x6cd41e467973dd1aull, 0x90a5cd35a361f3e8ull,
+        0xb4e7a2eae0c958baull, 0xd03c3c37f6d5947full, 0x2200758b5e133d58ull, 0xc2cf0a2b2affa196ull,
+        0x5b5cf50506ca6dddull, 0x4cea2dddb4c4c37eull, 0x993535319889163aull, 0x976228d6c59434a8ull,
+        0xd9cd76213988e5f8ull, 0x640b0cc4654dd7b7ull, 0xd412c2e516fb597full, 0xcb601b44e921986aull,
+        0x1a464e46bb98c092ull, 0x74c87d0058bcada9ull, 0xc132446ff88eb866ull, 0x5d11cb1ab96ed73dull,
+        0xc3668aad8871568aull, 0x28a858bced8cc35bull, 0xd36053a059659ee8ull, 0x40f5ad643bdd9b12ull,
+        0xa50ddd3c67ec60a0ull, 0xb9c6114c5fc2c1e7ull, 0x686e9a7382c1f9d4ull, 0x42f58be72c64fd3cull,
+        0xcd06adb5de5c88ecull, 0xdcc31ea7aa31b219ull, 0x2fcb6e315a098973ull, 0x1811e46a58f03d0bull,
+        0x33f543780c0783a8ull, 0x4d212f76679acc44ull, 0x5c859489bc5dcd0eull, 0xe826b919dbb821d5ull,
+        0xd53a17c8d93212cdull, 0x160e2b19dbb4baf0ull, 0x9061aa75dfb329dcull, 0x98655c4110e01484ull,
+        0x1a3f53eb6847ce5ull, 0xd5b2860ed076c516ull, 0x646e1e794709e613ull, 0x40a2db3046874340ull,
+        0x902cdfd5479139edull, 0x5b431556082e4ffaull, 0xba8d84070226f2c9ull, 0xf2b794d23adeac58ull,
+        0x6935ba40948a256cull, 0x43621847c6b08a51ull, 0x88326e40d44ef624ull, 0x576d4a5d315c4eb9ull,
+        0x2c0dce41cd4d0f94ull, 0xa19e1c4ceb76ca26ull, 0xe3c334c865c4bc13ull, 0x78a42ed1bf86d281ull,
+        0x2cd8776c18f57782ull, 0x125309821162937dull, 0xe2774d0cf04d6385ull, 0x8386aecaede864b6ull,
+        0x2ceb7104ea53549dull, 0xf61815e2c5dacd49ull, 0x3054d8ddb6884f96ull, 0x194e7833081620bcull,
+        0x2489161674cbbf2eull, 0xe2a0621d978723a7ull, 0x9c0c69d99536de2ull, 0xf4fec6f107d71b31ull,
+        0xd65d4f93955687c4ull, 0x7009033156a4d4f3ull, 0xbbbfeec49efd8d5bull, 0xa094e1cac3564decull,
+        0x3dd200368f05ab57ull, 0xab4de562010f8497ull, 0xf1d9dde62aeaf9dfull, 0x59b8992a0fd51705ull,
+        0x46ba770f5cde3ffbull, 0xafe89be133a1669dull, 0x1f8fd8a62c45f4eull, 0xe0c0e35383f9bd56ull,
+        0xfdb28093d0889921ull, 0xad51754f213cc564ull, 0x3ac1b638e83c8372ull, 0xd58b437c6178650full,
+        0x400bfb2fc3f3c717ull, 0xa7c5cc0d46b625ddull, 0xe9de1ae0e4d507b3ull, 0x978ca5e9022d2d08ull,
+        0x8bbc4899ee6024acull, 0xb394f52e83d73429ull, 0x6ae6b0e7e9691481ull, 0x8831c442f8c301b4ull,
+        0x57220530267b1b7ull, 0x2dbddc580c2ffee2ull, 0xbbb00aaa8ab9e06ull, 0x6c3f2d60bbd1277aull,
+        0x454970f466db3ce0ull, 0x709cfb570e61884cull, 0xcc0099c0fb47ccaull, 0x12402aebc25c8f51ull,
+        0x898610996d0460c1ull, 0xb544743f30fc84bull, 0x3681134ac046392cull, 0x54fd8760f92a1a30ull,
+        0xd0dc31ef27341a1full, 0xdd07f00f20dc2204ull, 0xba7a5b14b980cfa0ull, 0x397e496398052818ull,
+        0xec5ea03dece53dacull, 0xaf032234e4619cfbull, 0xbaabae6cc564e7efull, 0x221a79b22d178f5aull,
+        0x60671a913149c5e3ull, 0x6df609a695b15510ull, 0x6a21523f6823ac7full, 0x7a769b08af1e608ull,
+        0x32b35d32a8320a6full, 0x8ccf03ddac37d717ull, 0x1ab2568ef120ba89ull, 0x61d52519667c9aebull,
+        0xd443f65ec1e9211aull, 0xf7462bf23156cddbull, 0x627925223bac187eull, 0x87ec966d6906fe03ull,
+        0xe9d70056c68edfcdull, 0x84930e82524f5824ull
+    };
+    
+    const char* const SHIPPED_ID_NAMES[SHIPPED_ID_COUNT] = {
+        "first_meeting",
+        "shopkeeper",
+        "devil_fruit_nullification",
+        "nervous",
+        "change_reputation",
+        "kaya",
+        "foggy",
+        "speed",
+        "challenging",
+        "quality_katana",
+        "recruited",
+        "grateful",
+        "windmill_village",
+        "prove_worth",
+        "village",
+        "stubborn_response",
+        "leadership",
+        "superiority",
+        "item_obtained",
+        "about_arlong",
+        "cautious",
+        "accessory",
+        "hope_response",
+        "speed_boots",
+        "marine_coat",
+        "enemies",
+        "stern",
+        "angry",
+        "baratie_kitchen",
+        "commanding",
+        "story",
+        "start_quest",
+        "weather",
+        "specialAbility",
+        "sea_salt",
+        "road_poneglyph",
+        "kayas_mansion",
+        "nami",
+        "baratie",
+        "friendship_moment",
+        "cheerful",
+        "fishman_strength_serum",
+        "shells_town_weapons",
+        "Paradise",
+        "day_night",
+        "meat_order",
+        "sanji",
+        "seafood_curry",
+        "get_zoro_swords",
+        "berry_amount",
+        "reverse_mountain",
+        "lucky_charm",
+        "charisma",
+        "arlong_park",
+        "genzo",
+        "proud_response",
+        "friendly",
+        "boodle",
+        "reputation",
+        "health_potion",
+        "wise",
+        "quest",
+        "fighting_cook",
+        "feet",
+        "syrup_village",
+        "pirate_king_response",
+        "threatening",
+        "village_general_store",
+        "buggy",
+        "Red Line",
+        "armor",
+        "visited_locations",
+        "steel_ingot",
+        "authoritative",
+        "criticalChance",
+        "passionate",
+        "marine_rifle",
+        "restaurant_ship",
+        "luck",
+        "about_all_blue",
+        "demon_aura",
+        "dream_power",
+        "location_visited",
+        "serious",
+        "welcoming",
+        "rainy",
+        "focused",
+        "flag",
+        "key_items",
+        "recruit_zoro",
+        "hopeful_but_scared",
+        "extreme_hardness",
+        "accessories",
+        "whisky_peak",
+        "pleased",
+        "conditions_set",
+        "zoro_recruitment_started",
+        "worried",
+        "none",
+        "ancient_artifact",
+        "wapol_metal",
+        "sea_king_small",
+        "straw_hat",
+        "basic_sword",
+        "mayor_woop_slap",
+        "excited",
+        "grateful_response",
+        "decrease_loyalty",
+        "generic_pirate",
+        "usopp",
+        "saw_tooth_blade",
+        "prove_strength",
+        "weapon_shop",
+        "consumables",
+        "battle_start",
+        "determined",
+        "location",
+        "ready",
+        "den_den_mushi",
+        "battle_won",
+        "intrigued",
+        "marine_soldier",
+        "island",
+        "patty",
+        "perfect_balance",
+        "knowledgeable",
+        "zoro_challenge_accepted",
+        "confused",
+        "makino",
+        "set_quest",
+        "cursed_blade",
+        "explain_dream",
+        "save_cocoyasi_village",
+        "proud",
+        "3_piece",
+        "hopeful",
+        "pirate_captain_coat",
+        "boastful",
+        "cocoyasi_village",
+        "authority",
+        "play_sound",
+        "never_give_up",
+        "weapon",
+        "leather_armor",
+        "marine_boots",
+        "vivre_card",
+        "accuracy",
+        "pained",
+        "current_location",
+        "eternal_pose",
+        "villagers",
+        "clear",
+        "crocus",
+        "willpower",
+        "health",
+        "crew_size",
+        "smoker",
+        "energy_drink",
+        "level",
+        "game_time",
+        "weapons",
+        "change_location",
+        "give_item",
+        "seastone",
+        "mountain",
+        "mountain_bandit",
+        "treasures",
+        "orange_town",
+        "dropRate",
+        "set_flag",
+        "generic_villager",
+        "dreamy",
+        "chivalrous",
+        "pirate_reaction",
+        "2_piece",
+        "confident",
+        "drum_island",
+        "power_ring",
+        "captain_axe",
+        "defeat",
+        "end_conversation",
+        "storytelling",
+        "town",
+        "bell_mere",
+        "captain_morgan",
+        "yubashiri",
+        "materials",
+        "greedy",
+        "zeff",
+        "East Blue",
+        "windy",
+        "modify_stats",
+        "ring",
+        "wado_ichimonji",
+        "increase_loyalty",
+        "twin_capes",
+        "skeptical",
+        "zoro_swords",
+        "defeat_arlong",
+        "loguetown",
+        "curious",
+        "cloudy",
+        "inherited_will",
+        "communication",
+        "katana",
+        "trigger_battle",
+        "stormy",
+        "chest",
+        "arrogant",
+        "merry",
+        "arlong",
+        "crew_member_recruited",
+        "worried_citizen",
+        "gold_coin",
+        "explain_situation",
+        "shells_town",
+        "defense",
+        "marine_base",
+        "jeweled_crown",
+        "default",
+        "nami_promise_given",
+        "agility",
+        "touched",
+        "devil_fruit_awakening_serum",
+        "professional",
+        "bossy",
+        "range",
+        "caught_lying",
+        "surprised_then_guilty",
+        "scared",
+        "respectful",
+        "defeat_buggy",
+        "complete_quest",
+        "strength",
+        "luffy",
+        "loguetown_weapons",
+        "quest_completed",
+        "battle_ready",
+        "join_crew",
+        "bounty",
+        "grand_line_paradise",
+        "execution_platform",
+        "marine_captain",
+        "little_garden",
+        "fushia_village",
+        "head",
+        "east_blue",
+        "meat_special",
+        "pirate_king_reaction",
+        "grand_line_new_world",
+        "mr_8",
+        "attack",
+        "strong_dish",
+        "chopper",
+        "suspicious",
+        "sandai_kitetsu",
+        "loyal",
+        "desperate",
+        "rika",
+        "marine_officer",
+        "show_cutscene",
+        "zoro"
+    };
+}
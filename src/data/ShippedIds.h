@@ -0,0 +1,263 @@
+#pragma once
+// Generated by opmon_idgen from assets/data. Do not edit; build the update_ids target instead.
+#include "StringId.h"
+#include <cstdint>
+
+const std::uint32_t SHIPPED_ID_COUNT = 262;
+
+constexpr StringId ID_2_PIECE(174);
+constexpr StringId ID_3_PIECE(134);
+constexpr StringId ID_ABOUT_ALL_BLUE(79);
+constexpr StringId ID_ABOUT_ARLONG(19);
+constexpr StringId ID_ACCESSORIES(92);
+constexpr StringId ID_ACCESSORY(21);
+constexpr StringId ID_ACCURACY(146);
+constexpr StringId ID_AGILITY(221);
+constexpr StringId ID_ANCIENT_ARTIFACT(99);
+constexpr StringId ID_ANGRY(27);
+constexpr StringId ID_ARLONG(210);
+constexpr StringId ID_ARLONG_PARK(53);
+constexpr StringId ID_ARMOR(70);
+constexpr StringId ID_ARROGANT(208);
+constexpr StringId ID_ATTACK(251);
+constexpr StringId ID_AUTHORITATIVE(73);
+constexpr StringId ID_AUTHORITY(139);
+constexpr StringId ID_BARATIE(38);
+constexpr StringId ID_BARATIE_KITCHEN(28);
+constexpr StringId ID_BASIC_SWORD(103);
+constexpr StringId ID_BATTLE_READY(237);
+constexpr StringId ID_BATTLE_START(114);
+constexpr StringId ID_BATTLE_WON(119);
+constexpr StringId ID_BELL_MERE(183);
+constexpr StringId ID_BERRY_AMOUNT(49);
+constexpr StringId ID_BOASTFUL(137);
+constexpr StringId ID_BOODLE(57);
+constexpr StringId ID_BOSSY(225);
+constexpr StringId ID_BOUNTY(239);
+constexpr StringId ID_BUGGY(68);
+constexpr StringId ID_CAPTAIN_AXE(178);
+constexpr StringId ID_CAPTAIN_MORGAN(184);
+constexpr StringId ID_CAUGHT_LYING(227);
+constexpr StringId ID_CAUTIOUS(20);
+constexpr StringId ID_CHALLENGING(8);
+constexpr StringId ID_CHANGE_LOCATION(161);
+constexpr StringId ID_CHANGE_REPUTATION(4);
+constexpr StringId ID_CHARISMA(52);
+constexpr StringId ID_CHEERFUL(40);
+constexpr StringId ID_CHEST(207);
+constexpr StringId ID_CHIVALROUS(172);
+constexpr StringId ID_CHOPPER(253);
+constexpr StringId ID_CLEAR(151);
+constexpr StringId ID_CLOUDY(201);
+constexpr StringId ID_COCOYASI_VILLAGE(138);
+constexpr StringId ID_COMMANDING(29);
+constexpr StringId ID_COMMUNICATION(203);
+constexpr StringId ID_COMPLETE_QUEST(232);
+constexpr StringId ID_CONDITIONS_SET(95);
+constexpr StringId ID_CONFIDENT(175);
+constexpr StringId ID_CONFUSED(127);
+constexpr StringId ID_CONSUMABLES(113);
+constexpr StringId ID_CREW_MEMBER_RECRUITED(211);
+constexpr StringId ID_CREW_SIZE(155);
+constexpr StringId ID_CROCUS(152);
+constexpr StringId ID_CURIOUS(200);
+constexpr StringId ID_CURRENT_LOCATION(148);
+constexpr StringId ID_CURSED_BLADE(130);
+constexpr StringId ID_DAY_NIGHT(44);
+constexpr StringId ID_DECREASE_LOYALTY(107);
+constexpr StringId ID_DEFAULT(219);
+constexpr StringId ID_DEFEAT(179);
+constexpr StringId ID_DEFEAT_ARLONG(198);
+constexpr StringId ID_DEFEAT_BUGGY(231);
+constexpr StringId ID_DEFENSE(216);
+constexpr StringId ID_DEMON_AURA(80);
+constexpr StringId ID_DEN_DEN_MUSHI(118);
+constexpr StringId ID_DESPERATE(257);
+constexpr StringId ID_DETERMINED(115);
+constexpr StringId ID_DEVIL_FRUIT_AWAKENING_SERUM(223);
+constexpr StringId ID_DEVIL_FRUIT_NULLIFICATION(2);
+constexpr StringId ID_DREAM_POWER(81);
+constexpr StringId ID_DREAMY(171);
+constexpr StringId ID_DRUM_ISLAND(176);
+constexpr StringId ID_EAST_BLUE(246);
+constexpr StringId ID_END_CONVERSATION(180);
+constexpr StringId ID_ENEMIES(25);
+constexpr StringId ID_ENERGY_DRINK(157);
+constexpr StringId ID_ETERNAL_POSE(149);
+constexpr StringId ID_EXCITED(105);
+constexpr StringId ID_EXECUTION_PLATFORM(241);
+constexpr StringId ID_EXPLAIN_DREAM(131);
+constexpr StringId ID_EXPLAIN_SITUATION(214);
+constexpr StringId ID_EXTREME_HARDNESS(91);
+constexpr StringId ID_FEET(63);
+constexpr StringId ID_FIGHTING_COOK(62);
+constexpr StringId ID_FIRST_MEETING(0);
+constexpr StringId ID_FISHMAN_STRENGTH_SERUM(41);
+constexpr StringId ID_FLAG(87);
+constexpr StringId ID_FOCUSED(86);
+constexpr StringId ID_FOGGY(6);
+constexpr StringId ID_FRIENDLY(56);
+constexpr StringId ID_FRIENDSHIP_MOMENT(39);
+constexpr StringId ID_FUSHIA_VILLAGE(244);
+constexpr StringId ID_GAME_TIME(159);
+constexpr StringId ID_GENERIC_PIRATE(108);
+constexpr StringId ID_GENERIC_VILLAGER(170);
+constexpr StringId ID_GENZO(54);
+constexpr StringId ID_GET_ZORO_SWORDS(48);
+constexpr StringId ID_GIVE_ITEM(162);
+constexpr StringId ID_GOLD_COIN(213);
+constexpr StringId ID_GRAND_LINE_NEW_WORLD(249);
+constexpr StringId ID_GRAND_LINE_PARADISE(240);
+constexpr StringId ID_GRATEFUL(11);
+constexpr StringId ID_GRATEFUL_RESPONSE(106);
+constexpr StringId ID_GREEDY(187);
+constexpr StringId ID_HEAD(245);
+constexpr StringId ID_HEALTH(154);
+constexpr StringId ID_HEALTH_POTION(59);
+constexpr StringId ID_HOPE_RESPONSE(22);
+constexpr StringId ID_HOPEFUL(135);
+constexpr StringId ID_HOPEFUL_BUT_SCARED(90);
+constexpr StringId ID_INCREASE_LOYALTY(194);
+constexpr StringId ID_INHERITED_WILL(202);
+constexpr StringId ID_INTRIGUED(120);
+constexpr StringId ID_ISLAND(122);
+constexpr StringId ID_ITEM_OBTAINED(18);
+constexpr StringId ID_JEWELED_CROWN(218);
+constexpr StringId ID_JOIN_CREW(238);
+constexpr StringId ID_KATANA(204);
+constexpr StringId ID_KAYA(5);
+constexpr StringId ID_KAYAS_MANSION(36);
+constexpr StringId ID_KEY_ITEMS(88);
+constexpr StringId ID_KNOWLEDGEABLE(125);
+constexpr StringId ID_LEADERSHIP(16);
+constexpr StringId ID_LEATHER_ARMOR(143);
+constexpr StringId ID_LEVEL(158);
+constexpr StringId ID_LITTLE_GARDEN(243);
+constexpr StringId ID_LOCATION(116);
+constexpr StringId ID_LOCATION_VISITED(82);
+constexpr StringId ID_LOGUETOWN(199);
+constexpr StringId ID_LOGUETOWN_WEAPONS(235);
+constexpr StringId ID_LOYAL(256);
+constexpr StringId ID_LUCK(78);
+constexpr StringId ID_LUCKY_CHARM(51);
+constexpr StringId ID_LUFFY(234);
+constexpr StringId ID_MAKINO(128);
+constexpr StringId ID_MARINE_BASE(217);
+constexpr StringId ID_MARINE_BOOTS(144);
+constexpr StringId ID_MARINE_CAPTAIN(242);
+constexpr StringId ID_MARINE_COAT(24);
+constexpr StringId ID_MARINE_OFFICER(259);
+constexpr StringId ID_MARINE_RIFLE(76);
+constexpr StringId ID_MARINE_SOLDIER(121);
+constexpr StringId ID_MATERIALS(186);
+constexpr StringId ID_MAYOR_WOOP_SLAP(104);
+constexpr StringId ID_MEAT_ORDER(45);
+constexpr StringId ID_MEAT_SPECIAL(247);
+constexpr StringId ID_MERRY(209);
+constexpr StringId ID_MODIFY_STATS(191);
+constexpr StringId ID_MOUNTAIN(164);
+constexpr StringId ID_MOUNTAIN_BANDIT(165);
+constexpr StringId ID_MR_8(250);
+constexpr StringId ID_NAMI(37);
+constexpr StringId ID_NAMI_PROMISE_GIVEN(220);
+constexpr StringId ID_NERVOUS(3);
+constexpr StringId ID_NEVER_GIVE_UP(141);
+constexpr StringId ID_NONE(98);
+constexpr StringId ID_ORANGE_TOWN(167);
+constexpr StringId ID_PAINED(147);
+constexpr StringId ID_PASSIONATE(75);
+constexpr StringId ID_PATTY(123);
+constexpr StringId ID_PERFECT_BALANCE(124);
+constexpr StringId ID_PIRATE_CAPTAIN_COAT(136);
+constexpr StringId ID_PIRATE_KING_REACTION(248);
+constexpr StringId ID_PIRATE_KING_RESPONSE(65);
+constexpr StringId ID_PIRATE_REACTION(173);
+constexpr StringId ID_PLAY_SOUND(140);
+constexpr StringId ID_PLEASED(94);
+constexpr StringId ID_POWER_RING(177);
+constexpr StringId ID_PROFESSIONAL(224);
+constexpr StringId ID_PROUD(133);
+constexpr StringId ID_PROUD_RESPONSE(55);
+constexpr StringId ID_PROVE_STRENGTH(111);
+constexpr StringId ID_PROVE_WORTH(13);
+constexpr StringId ID_QUALITY_KATANA(9);
+constexpr StringId ID_QUEST(61);
+constexpr StringId ID_QUEST_COMPLETED(236);
+constexpr StringId ID_RAINY(85);
+constexpr StringId ID_RANGE(226);
+constexpr StringId ID_READY(117);
+constexpr StringId ID_RECRUIT_ZORO(89);
+constexpr StringId ID_RECRUITED(10);
+constexpr StringId ID_REPUTATION(58);
+constexpr StringId ID_RESPECTFUL(230);
+constexpr StringId ID_RESTAURANT_SHIP(77);
+constexpr StringId ID_REVERSE_MOUNTAIN(50);
+constexpr StringId ID_RIKA(258);
+constexpr StringId ID_RING(192);
+constexpr StringId ID_ROAD_PONEGLYPH(35);
+constexpr StringId ID_SANDAI_KITETSU(255);
+constexpr StringId ID_SANJI(46);
+constexpr StringId ID_SAVE_COCOYASI_VILLAGE(132);
+constexpr StringId ID_SAW_TOOTH_BLADE(110);
+constexpr StringId ID_SCARED(229);
+constexpr StringId ID_SEA_KING_SMALL(101);
+constexpr StringId ID_SEA_SALT(34);
+constexpr StringId ID_SEAFOOD_CURRY(47);
+constexpr StringId ID_SEASTONE(163);
+constexpr StringId ID_SERIOUS(83);
+constexpr StringId ID_SET_FLAG(169);
+constexpr StringId ID_SET_QUEST(129);
+constexpr StringId ID_SHELLS_TOWN(215);
+constexpr StringId ID_SHELLS_TOWN_WEAPONS(42);
+constexpr StringId ID_SHOPKEEPER(1);
+constexpr StringId ID_SHOW_CUTSCENE(260);
+constexpr StringId ID_SKEPTICAL(196);
+constexpr StringId ID_SMOKER(156);
+constexpr StringId ID_SPEED(7);
+constexpr StringId ID_SPEED_BOOTS(23);
+constexpr StringId ID_START_QUEST(31);
+constexpr StringId ID_STEEL_INGOT(72);
+constexpr StringId ID_STERN(26);
+constexpr StringId ID_STORMY(206);
+constexpr StringId ID_STORY(30);
+constexpr StringId ID_STORYTELLING(181);
+constexpr StringId ID_STRAW_HAT(102);
+constexpr StringId ID_STRENGTH(233);
+constexpr StringId ID_STRONG_DISH(252);
+constexpr StringId ID_STUBBORN_RESPONSE(15);
+constexpr StringId ID_SUPERIORITY(17);
+constexpr StringId ID_SURPRISED_THEN_GUILTY(228);
+constexpr StringId ID_SUSPICIOUS(254);
+constexpr StringId ID_SYRUP_VILLAGE(64);
+constexpr StringId ID_THREATENING(66);
+constexpr StringId ID_TOUCHED(222);
+constexpr StringId ID_TOWN(182);
+constexpr StringId ID_TREASURES(166);
+constexpr StringId ID_TRIGGER_BATTLE(205);
+constexpr StringId ID_TWIN_CAPES(195);
+constexpr StringId ID_USOPP(109);
+constexpr StringId ID_VILLAGE(14);
+constexpr StringId ID_VILLAGE_GENERAL_STORE(67);
+constexpr StringId ID_VILLAGERS(150);
+constexpr StringId ID_VISITED_LOCATIONS(71);
+constexpr StringId ID_VIVRE_CARD(145);
+constexpr StringId ID_WADO_ICHIMONJI(193);
+constexpr StringId ID_WAPOL_METAL(100);
+constexpr StringId ID_WEAPON(142);
+constexpr StringId ID_WEAPON_SHOP(112);
+constexpr StringId ID_WEAPONS(160);
+constexpr StringId ID_WEATHER(32);
+constexpr StringId ID_WELCOMING(84);
+constexpr StringId ID_WHISKY_PEAK(93);
+constexpr StringId ID_WILLPOWER(153);
+constexpr StringId ID_WINDMILL_VILLAGE(12);
+constexpr StringId ID_WINDY(190);
+constexpr StringId ID_WISE(60);
+constexpr StringId ID_WORRIED(97);
+constexpr StringId ID_WORRIED_CITIZEN(212);
+constexpr StringId ID_YUBASHIRI(185);
+constexpr StringId ID_ZEFF(188);
+constexpr StringId ID_ZORO(261);
+constexpr StringId ID_ZORO_CHALLENGE_ACCEPTED(126);
+constexpr StringId ID_ZORO_RECRUITMENT_STARTED(96);
+constexpr StringId ID_ZORO_SWORDS(197);
@@ -0,0 +1,40 @@
+#include "StringArena.h"
+#include <cstring>
+
+StringArena::StringArena(std::size_t defaultBlockSize)
+    : blockSize(defaultBlockSize), blockUsed(defaultBlockSize), bytesUsed(0) {
+}
+
+std::string_view StringArena::store(std::string_view text) {
+    std::size_t needed = text.size() + 1;
+    
+    // Oversized strings get a block of their own; the partly used block
+    // stays last so small strings keep filling it
+    if (needed > blockSize / 4) {
+        std::unique_ptr<char[]> block(new char[needed]);
+        char* copy = block.get();
+        blocks.insert(blocks.empty() ? blocks.end() : blocks.end() - 1, std::move(block));
+        std::memcpy(copy, text.data(), text.size());
+        copy[text.size()] = '\0';
+        bytesUsed += needed;
+        return std::string_view(copy, text.size());
+    }
+    
+    if (blockUsed + needed > blockSize) {
+        blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
+        blockUsed = 0;
+    }
+    
+    char* copy = blocks.back().get() + blockUsed;
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+    blockUsed += needed;
+    bytesUsed += needed;
+    return std::string_view(copy, text.size());
+}
+
+void StringArena::clear() {
+    blocks.clear();
+    blockUsed = blockSize;
+    bytesUsed = 0;
+}
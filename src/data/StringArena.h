@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Append-only storage for strings that live as long as the loaded data.
+// Strings are copied into large blocks, so storing one rarely allocates and
+// returned views never move.
+class StringArena {
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t blockSize;
+    std::size_t blockUsed;
+    std::size_t bytesUsed;
+
+public:
+    explicit StringArena(std::size_t defaultBlockSize = 64 * 1024);
+    
+    // Returns a NUL-terminated copy of text
+    std::string_view store(std::string_view text);
+    void clear();
+    
+    std::size_t getBytesUsed() const { return bytesUsed; }
+    std::size_t getBlockCount() const { return blocks.size(); }
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Dense identifier for an interned string. Shipped identifiers have fixed
+// values (see ShippedIds.h); anything else is numbered after them in the
+// order it is first interned.
+struct StringId {
+    static const std::uint32_t INVALID = 0xFFFFFFFFu;
+    
+    std::uint32_t index = INVALID;
+    
+    constexpr StringId() = default;
+    constexpr explicit StringId(std::uint32_t value) : index(value) {}
+    
+    constexpr bool isValid() const { return index != INVALID; }
+    constexpr bool operator==(StringId other) const { return index == other.index; }
+    constexpr bool operator!=(StringId other) const { return index != other.index; }
+    constexpr bool operator<(StringId other) const { return index < other.index; }
+};
+
+namespace std {
+    template<>
+    struct hash<StringId> {
+        std::size_t operator()(StringId id) const { return id.index; }
+    };
+}
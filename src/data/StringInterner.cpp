@@ -0,0 +1,97 @@
+#include "StringInterner.h"
+#include "IdHash.h"
+#include "ShippedIdTable.h"
+
+namespace {
+    const std::size_t INITIAL_TABLE_SIZE = 256;
+}
+
+StringInterner::StringInterner() : strings(16 * 1024), dynamicCount(0) {
+    names.assign(SHIPPED_ID_NAMES, SHIPPED_ID_NAMES + SHIPPED_ID_COUNT);
+    table.assign(INITIAL_TABLE_SIZE, Entry{ 0, StringId::INVALID });
+}
+
+StringInterner& StringInterner::instance() {
+    static StringInterner interner;
+    return interner;
+}
+
+StringId StringInterner::findShipped(std::uint64_t hash) {
+    std::uint32_t seed = SHIPPED_BUCKET_SEEDS[perfectHashBucket(hash, SHIPPED_BUCKET_COUNT)];
+    std::uint32_t slot = perfectHashSlot(hash, seed, SHIPPED_ID_COUNT);
+    return SHIPPED_SLOT_HASHES[slot] == hash ? StringId(slot) : StringId();
+}
+
+StringId StringInterner::findDynamic(std::string_view text, std::uint64_t hash) const {
+    std::size_t mask = table.size() - 1;
+    for (std::size_t i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask) {
+        const Entry& entry = table[i];
+        if (entry.index == StringId::INVALID) {
+            return StringId();
+        }
+        if (entry.hash == hash && names[entry.index] == text) {
+            return StringId(entry.index);
+        }
+    }
+}
+
+void StringInterner::grow() {
+    std::vector<Entry> old;
+    old.swap(table);
+    table.assign(old.size() * 2, Entry{ 0, StringId::INVALID });
+    
+    std::size_t mask = table.size() - 1;
+    for (const Entry& entry : old) {
+        if (entry.index == StringId::INVALID) {
+            continue;
+        }
+        std::size_t i = static_cast<std::size_t>(entry.hash) & mask;
+        while (table[i].index != StringId::INVALID) {
+            i = (i + 1) & mask;
+        }
+        table[i] = entry;
+    }
+}
+
+StringId StringInterner::intern(std::string_view text) {
+    std::uint64_t hash = hashId(text);
+    StringId id = findShipped(hash);
+    if (id.isValid()) {
+        return id;
+    }
+    id = findDynamic(text, hash);
+    if (id.isValid()) {
+        return id;
+    }
+    
+    // Keep the load factor under one half
+    if ((dynamicCount + 1) * 2 > table.size()) {
+        grow();
+    }
+    
+    id = StringId(static_cast<std::uint32_t>(names.size()));
+    names.push_back(strings.store(text));
+    ++dynamicCount;
+    
+    std::size_t mask = table.size() - 1;
+    std::size_t i = static_cast<std::size_t>(hash) & mask;
+    while (table[i].index != StringId::INVALID) {
+        i = (i + 1) & mask;
+    }
+    table[i] = Entry{ hash, id.index };
+    return id;
+}
+
+StringId StringInterner::find(std::string_view text) const {
+    std::uint64_t hash = hashId(text);
+    StringId id = findShipped(hash);
+    return id.isValid() ? id : findDynamic(text, hash);
+}
+
+std::string_view StringInterner::name(StringId id) const {
+    return id.index < names.size() ? names[id.index] : std::string_view();
+}
+
+std::size_t StringInterner::getShippedCount() const {
+    return SHIPPED_ID_COUNT;
+}
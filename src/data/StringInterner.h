@@ -0,0 +1,49 @@
+#pragma once
+#include "StringArena.h"
+#include "StringId.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Maps identifiers to dense StringIds. Identifiers from the shipped data
+// resolve through the generated minimal perfect hash (one hash, one seed
+// lookup, one fingerprint compare) and keep the ids in ShippedIds.h.
+// Anything else, such as modded content, goes to an open-addressing table
+// and is numbered after the shipped ids.
+//
+// Ids are never released, so they stay valid across data reloads. Intern
+// from one thread (normally while loading).
+class StringInterner {
+private:
+    struct Entry {
+        std::uint64_t hash;
+        std::uint32_t index;
+    };
+    
+    StringArena strings;
+    std::vector<std::string_view> names;
+    std::vector<Entry> table; // Power-of-two capacity, index INVALID when empty
+    std::size_t dynamicCount;
+    
+    static StringId findShipped(std::uint64_t hash);
+    StringId findDynamic(std::string_view text, std::uint64_t hash) const;
+    void grow();
+
+public:
+    StringInterner();
+    
+    static StringInterner& instance();
+    
+    // Returns the id of text, adding it if needed
+    StringId intern(std::string_view text);
+    // Returns an invalid id if text was never interned
+    StringId find(std::string_view text) const;
+    
+    // NUL-terminated; empty for invalid ids
+    std::string_view name(StringId id) const;
+    
+    std::size_t size() const { return names.size(); }
+    std::size_t getShippedCount() const;
+    std::size_t getDynamicCount() const { return dynamicCount; }
+};
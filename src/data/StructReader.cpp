@@ -0,0 +1,237 @@
+#include "StructReader.h"
+#include <charconv>
+
+namespace {
+    const char* const VALUE_NAMES[] = { "null", "bool", "integer", "number", "string", "object", "array" };
+}
+
+StructReader::StructReader(void* record, const TypeInfo& type, const ReadContext& readContext)
+    : context(readContext), pending(record), pendingType(&type), pendingAdd(false), mismatchCount(0) {
+    frames.reserve(16);
+}
+
+const TypeInfo* StructReader::unwrapped(const TypeInfo* type) {
+    while (type->kind == TypeKind::Optional) {
+        type = type->element;
+    }
+    return type;
+}
+
+bool StructReader::accepts(const TypeInfo* type, ValueKind kind) {
+    // Null leaves anything but an optional at its default
+    if (kind == ValueKind::Null) {
+        return true;
+    }
+    
+    type = unwrapped(type);
+    switch (kind) {
+        case ValueKind::Bool:
+            return type->kind == TypeKind::Bool;
+        case ValueKind::Integer:
+        case ValueKind::Number:
+            return type->kind == TypeKind::Int || type->kind == TypeKind::Float;
+        case ValueKind::String:
+            return type->kind == TypeKind::String || type->kind == TypeKind::Id;
+        case ValueKind::Object:
+            return type->kind == TypeKind::Struct || type->kind == TypeKind::Map || (type->kind == TypeKind::Array && type->capacity > 0);
+        default:
+            return type->kind == TypeKind::Array;
+    }
+}
+
+bool StructReader::nextTarget(ValueKind kind, void*& target, const TypeInfo*& type) {
+    // Set when the value becomes a new element of this array or map
+    void* container = nullptr;
+    const TypeInfo* containerType = nullptr;
+    std::string_view key;
+    target = nullptr;
+    
+    if (frames.empty() || frames.back().isObject) {
+        // The root, or a member selected by the last key
+        if (pendingAdd) {
+            container = pending;
+            containerType = pendingType;
+            key = lastKey;
+            type = pendingType->element;
+        } else {
+            target = pending;
+            type = pendingType;
+        }
+        pending = nullptr;
+        pendingAdd = false;
+    } else {
+        Frame& frame = frames.back();
+        if (!frame.type) {
+            return false;
+        }
+        
+        type = frame.type->element;
+        if (frame.type->capacity > 0) {
+            target = frame.type->elementAt(frame.object, frame.index++);
+            if (!target) {
+                mismatch("extra array element");
+            }
+        } else {
+            container = frame.object;
+            containerType = frame.type;
+        }
+    }
+    
+    if (!target && !container) {
+        return false;
+    }
+    if (!accepts(type, kind)) {
+        mismatch(unwrapped(type), kind);
+        return false;
+    }
+    
+    if (container) {
+        target = containerType->add(container, key, context);
+    }
+    while (kind != ValueKind::Null && type->kind == TypeKind::Optional) {
+        target = type->add(target, std::string_view(), context);
+        type = type->element;
+    }
+    return true;
+}
+
+bool StructReader::startContainer(ValueKind kind) {
+    void* target;
+    const TypeInfo* type;
+    if (!nextTarget(kind, target, type)) {
+        frames.push_back({ nullptr, nullptr, 0, kind == ValueKind::Object });
+        return true;
+    }
+    
+    frames.push_back({ target, type, 0, kind == ValueKind::Object });
+    return true;
+}
+
+void StructReader::mismatch(const TypeInfo* expected, ValueKind found) {
+    ++mismatchCount;
+    if (error.empty()) {
+        error = "'" + lastKey + "': expected " + expected->name + ", found " + VALUE_NAMES[static_cast<int>(found)];
+    }
+}
+
+void StructReader::mismatch(const char* problem) {
+    ++mismatchCount;
+    if (error.empty()) {
+        error = "'" + lastKey + "': " + problem;
+    }
+}
+
+bool StructReader::null() {
+    void* target;
+    const TypeInfo* type;
+    if (nextTarget(ValueKind::Null, target, type) && type->kind == TypeKind::Optional) {
+        type->reset(target);
+    }
+    return true;
+}
+
+bool StructReader::boolean(bool value) {
+    void* target;
+    const TypeInfo* type;
+    if (nextTarget(ValueKind::Bool, target, type)) {
+        type->setBool(target, value);
+    }
+    return true;
+}
+
+bool StructReader::number_integer(std::int64_t value) {
+    void* target;
+    const TypeInfo* type;
+    if (nextTarget(ValueKind::Integer, target, type)) {
+        type->setInt(target, value);
+    }
+    return true;
+}
+
+bool StructReader::number_unsigned(std::uint64_t value) {
+    // Past INT64_MAX the value is kept as a double, as JsonTape and the
+    // database compiler do
+    if (value > static_cast<std::uint64_t>(INT64_MAX)) {
+        return number_float(static_cast<double>(value), std::string());
+    }
+    return number_integer(static_cast<std::int64_t>(value));
+}
+
+bool StructReader::number_float(double value, const std::string&) {
+    void* target;
+    const TypeInfo* type;
+    if (nextTarget(ValueKind::Number, target, type)) {
+        type->setFloat(target, value);
+    }
+    return true;
+}
+
+bool StructReader::string(std::string& value) {
+    void* target;
+    const TypeInfo* type;
+    if (nextTarget(ValueKind::String, target, type)) {
+        type->setString(target, value, context);
+    }
+    return true;
+}
+
+bool StructReader::start_object(std::size_t) {
+    return startContainer(ValueKind::Object);
+}
+
+bool StructReader::key(std::string& value) {
+    lastKey.assign(value);
+    pending = nullptr;
+    pendingAdd = false;
+    
+    Frame& frame = frames.back();
+    if (!frame.type) {
+        return true;
+    }
+    
+    switch (frame.type->kind) {
+        case TypeKind::Struct: {
+            const FieldInfo* field = frame.type->findField(value);
+            if (field && field == frame.type->restField) {
+                pending = field->access(frame.object);
+                pendingType = field->type;
+                pendingAdd = true;
+            } else if (field) {
+                pending = field->access(frame.object);
+                pendingType = field->type;
+            }
+            break;
+        }
+        case TypeKind::Map:
+            pending = frame.object;
+            pendingType = frame.type;
+            pendingAdd = true;
+            break;
+        default: {
+            // Fixed-size array written as an object keyed by index
+            std::size_t index = frame.type->capacity;
+            std::from_chars(value.data(), value.data() + value.size(), index);
+            pending = frame.type->elementAt(frame.object, index);
+            pendingType = frame.type->element;
+            if (!pending) {
+                mismatch("index out of range");
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool StructReader::end_object() {
+    frames.pop_back();
+    return true;
+}
+
+bool StructReader::start_array(std::size_t) {
+    return startContainer(ValueKind::Array);
+}
+
+bool StructReader::end_array() {
+    frames.pop_back();
+    return true;
+}
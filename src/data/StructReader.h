@@ -0,0 +1,92 @@
+#pragma once
+#include "Reflection.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// SAX handler that deserializes straight into a reflected record. It
+// follows the nlohmann::json_sax interface, so the same reader works with
+// nlohmann::json::sax_parse, JsonTape::replay and DbValue::replay.
+//
+// Identifiers are interned and other strings copied into the context's
+// arena; the only other allocations are the containers of the record
+// itself. Unknown keys are skipped. A value of the wrong type is skipped
+// and counted so a loader can report it without losing the rest of the
+// file.
+class StructReader {
+private:
+    enum class ValueKind {
+        Null,
+        Bool,
+        Integer,
+        Number,
+        String,
+        Object,
+        Array
+    };
+    
+    struct Frame {
+        void* object;
+        const TypeInfo* type; // nullptr while skipping a container
+        std::size_t index;
+        bool isObject;
+    };
+    
+    ReadContext context;
+    std::vector<Frame> frames;
+    // Member selected by the last key. When pendingAdd is set, pending is
+    // instead a map that gets an entry named lastKey once the value's type
+    // has been checked
+    void* pending;
+    const TypeInfo* pendingType;
+    bool pendingAdd;
+    std::string lastKey;
+    std::size_t mismatchCount;
+    std::string error;
+    
+    static const TypeInfo* unwrapped(const TypeInfo* type);
+    static bool accepts(const TypeInfo* type, ValueKind kind);
+    
+    // Where the next value goes, with optionals engaged unless the value is
+    // null. False when it should be skipped; a value of the wrong type is
+    // counted and creates no array element, map entry or optional
+    bool nextTarget(ValueKind kind, void*& target, const TypeInfo*& type);
+    bool startContainer(ValueKind kind);
+    void mismatch(const TypeInfo* expected, ValueKind found);
+    void mismatch(const char* problem);
+
+public:
+    template<class T>
+    StructReader(T& record, const ReadContext& readContext) : StructReader(&record, typeOf<T>(), readContext) {}
+    StructReader(void* record, const TypeInfo& type, const ReadContext& readContext);
+    
+    bool null();
+    bool boolean(bool value);
+    bool number_integer(std::int64_t value);
+    bool number_unsigned(std::uint64_t value);
+    bool number_float(double value, const std::string& text);
+    bool string(std::string& value);
+    bool start_object(std::size_t elements);
+    bool key(std::string& value);
+    bool end_object();
+    bool start_array(std::size_t elements);
+    bool end_array();
+    
+    template<class Binary>
+    bool binary(Binary&) {
+        mismatch("binary");
+        return true;
+    }
+    
+    template<class Exception>
+    bool parse_error(std::size_t, const std::string&, const Exception& exception) {
+        error = exception.what();
+        return false;
+    }
+    
+    // First problem found: a parse error, or the first type mismatch
+    const std::string& getError() const { return error; }
+    std::size_t getMismatchCount() const { return mismatchCount; }
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include "Profiler.h"
+#include "TraceRecorder.h"
+
+// Instrumentation entry points used by the game code. With
+// OPMON_ENABLE_PROFILER undefined every macro expands to nothing.
+//
+//   OPMON_PROFILE_SCOPE(phase)  times the scope into a Profiler phase and
+//                               emits a matching trace event
+//   OPMON_TRACE_SCOPE("name")   emits trace events only
+
+#define OPMON_INSTRUMENT_CONCAT_INNER(a, b) a##b
+#define OPMON_INSTRUMENT_CONCAT(a, b) OPMON_INSTRUMENT_CONCAT_INNER(a, b)
+
+#ifdef OPMON_ENABLE_PROFILER
+#define OPMON_PROFILE_BEGIN_FRAME() \
+    (Profiler::instance().beginFrame(), TraceRecorder::instance().beginFrame())
+#define OPMON_PROFILE_END_FRAME() \
+    (TraceRecorder::instance().end("Frame"), Profiler::instance().endFrame())
+#define OPMON_PROFILE_SCOPE(phase) \
+    ProfileScope OPMON_INSTRUMENT_CONCAT(profileScope, __LINE__)(phase); \
+    TraceScope OPMON_INSTRUMENT_CONCAT(traceScope, __LINE__)(Profiler::phaseName(phase))
+#define OPMON_TRACE_SCOPE(name) TraceScope OPMON_INSTRUMENT_CONCAT(traceScope, __LINE__)(name)
+#define OPMON_PROFILE_RENDER_SKIPPED() Profiler::instance().markRenderSkipped()
+#else
+#define OPMON_PROFILE_BEGIN_FRAME() ((void)0)
+#define OPMON_PROFILE_END_FRAME() ((void)0)
+#define OPMON_PROFILE_SCOPE(phase) ((void)0)
+#define OPMON_TRACE_SCOPE(name) ((void)0)
+#define OPMON_PROFILE_RENDER_SKIPPED() ((void)0)
+#endif
@@ -0,0 +1,118 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <limits>
+
+Profiler::Profiler() : head(0), frameCount(0), currentNs(), cpuStart(0), inFrame(false), currentRendered(true) {
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::beginFrame() {
+    std::fill(std::begin(currentNs), std::end(currentNs), 0);
+    frameStart = Clock::now();
+    cpuStart = std::clock();
+    inFrame = true;
+    currentRendered = true;
+}
+
+void Profiler::endFrame() {
+    if (!inFrame) {
+        return;
+    }
+    inFrame = false;
+    
+    FrameRecord& record = history[head];
+    for (std::size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+        record.phaseMs[i] = currentNs[i] / 1.0e6f;
+    }
+    record.frameMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+    record.cpuMs = 1000.0f * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    record.rendered = currentRendered;
+    
+    head = (head + 1) % HISTORY_SIZE;
+    frameCount = std::min(frameCount + 1, HISTORY_SIZE);
+}
+
+void Profiler::addSample(ProfilePhase phase, std::int64_t nanoseconds) {
+    currentNs[static_cast<std::size_t>(phase)] += nanoseconds;
+}
+
+const Profiler::FrameRecord& Profiler::frame(std::size_t index) const {
+    std::size_t oldest = (head + HISTORY_SIZE - frameCount) % HISTORY_SIZE;
+    return history[(oldest + index) % HISTORY_SIZE];
+}
+
+Profiler::PhaseStats Profiler::computeStats(const float* samples, std::size_t count) const {
+    PhaseStats stats;
+    if (count == 0) {
+        return stats;
+    }
+    
+    float minValue = std::numeric_limits<float>::max();
+    float sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        minValue = std::min(minValue, samples[i]);
+        sum += samples[i];
+    }
+    
+    std::copy(samples, samples + count, scratch.begin());
+    std::size_t p99Index = std::min(count - 1, (count * 99) / 100);
+    std::nth_element(scratch.begin(), scratch.begin() + p99Index, scratch.begin() + count);
+    
+    stats.minMs = minValue;
+    stats.avgMs = sum / count;
+    stats.p99Ms = scratch[p99Index];
+    return stats;
+}
+
+Profiler::PhaseStats Profiler::getPhaseStats(ProfilePhase phase) const {
+    std::array<float, HISTORY_SIZE> samples;
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        samples[i] = frame(i).phaseMs[static_cast<std::size_t>(phase)];
+    }
+    return computeStats(samples.data(), frameCount);
+}
+
+Profiler::PhaseStats Profiler::getFrameStats() const {
+    std::array<float, HISTORY_SIZE> samples;
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        samples[i] = frame(i).frameMs;
+    }
+    return computeStats(samples.data(), frameCount);
+}
+
+float Profiler::getCpuUsage() const {
+    float cpuMs = 0;
+    float wallMs = 0;
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        cpuMs += frame(i).cpuMs;
+        wallMs += frame(i).frameMs;
+    }
+    return wallMs > 0 ? cpuMs / wallMs : 0;
+}
+
+std::size_t Profiler::getRenderedFrames() const {
+    std::size_t rendered = 0;
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        rendered += frame(i).rendered ? 1 : 0;
+    }
+    return rendered;
+}
+
+const char* Profiler::phaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Events: return "Events";
+        case ProfilePhase::Update: return "Update";
+        case ProfilePhase::Animation: return "Animation";
+        case ProfilePhase::Render: return "Render";
+        case ProfilePhase::Wait: return "Wait";
+        case ProfilePhase::Present: return "Present";
+        case ProfilePhase::ButtonUpdate: return "Button::update";
+        case ProfilePhase::ButtonDraw: return "Button::draw";
+        case ProfilePhase::Count: break;
+    }
+    return "Unknown";
+}
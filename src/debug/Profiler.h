@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <cstddef>
+#include <cstdint>
+
+// Phases timed by the frame profiler. Button phases are nested inside
+// Update and Render, so their time is also included in those.
+enum class ProfilePhase {
+    Events,
+    Update,
+    Animation,
+    Render,
+    Wait,
+    Present,
+    ButtonUpdate,
+    ButtonDraw,
+    Count
+};
+
+const std::size_t PROFILE_PHASE_COUNT = static_cast<std::size_t>(ProfilePhase::Count);
+
+// Records per-phase timings for the last HISTORY_SIZE frames in a fixed ring
+// buffer. Nothing here allocates after construction.
+class Profiler {
+public:
+    static constexpr std::size_t HISTORY_SIZE = 240;
+    
+    struct PhaseStats {
+        float minMs = 0;
+        float avgMs = 0;
+        float p99Ms = 0;
+    };
+    
+    struct FrameRecord {
+        float phaseMs[PROFILE_PHASE_COUNT] = {};
+        float frameMs = 0;
+        float cpuMs = 0;       // Process CPU time spent during the frame
+        bool rendered = true;  // False when the frame skipped render/present
+    };
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    
+    std::array<FrameRecord, HISTORY_SIZE> history;
+    std::size_t head;
+    std::size_t frameCount;
+    std::int64_t currentNs[PROFILE_PHASE_COUNT];
+    Clock::time_point frameStart;
+    std::clock_t cpuStart;
+    bool inFrame;
+    bool currentRendered;
+    
+    // Scratch space for percentile queries
+    mutable std::array<float, HISTORY_SIZE> scratch;
+    
+    PhaseStats computeStats(const float* samples, std::size_t count) const;
+
+public:
+    Profiler();
+    
+    static Profiler& instance();
+    
+    void beginFrame();
+    void endFrame();
+    void addSample(ProfilePhase phase, std::int64_t nanoseconds);
+    void markRenderSkipped() { currentRendered = false; }
+    
+    // Number of frames currently held in the history (at most HISTORY_SIZE)
+    std::size_t size() const { return frameCount; }
+    
+    // Frames ordered from oldest (0) to newest (size() - 1)
+    const FrameRecord& frame(std::size_t index) const;
+    
+    PhaseStats getPhaseStats(ProfilePhase phase) const;
+    PhaseStats getFrameStats() const;
+    
+    // Process CPU time over wall time across the history (1.0 = one core busy)
+    float getCpuUsage() const;
+    std::size_t getRenderedFrames() const;
+    
+    static const char* phaseName(ProfilePhase phase);
+};
+
+// Adds the lifetime of the scope to the given phase of the current frame
+class ProfileScope {
+private:
+    ProfilePhase phase;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ProfileScope(ProfilePhase scopePhase)
+        : phase(scopePhase), start(std::chrono::steady_clock::now()) {}
+    
+    ~ProfileScope() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        Profiler::instance().addSample(phase, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
@@ -0,0 +1,120 @@
+#include "ProfilerOverlay.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    const float PANEL_WIDTH = 400;
+    const float PANEL_HEIGHT = 300;
+    const float GRAPH_HEIGHT = 60;
+    const float GRAPH_MAX_MS = 33.3f;
+    const float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+    const int TEXT_REFRESH_FRAMES = 15;
+}
+
+ProfilerOverlay::ProfilerOverlay(sf::Vector2f position)
+    : graph(sf::Quads, Profiler::HISTORY_SIZE * 4), budgetLine(sf::Lines, 2), visible(false), framesUntilTextRefresh(0) {
+    panel.setSize(sf::Vector2f(PANEL_WIDTH, PANEL_HEIGHT));
+    panel.setPosition(position);
+    panel.setFillColor(sf::Color(0, 0, 0, 170));
+    
+    statsText.setCharacterSize(13);
+    statsText.setFillColor(sf::Color(220, 220, 220));
+    statsText.setPosition(position.x + 8, position.y + 6);
+    
+    graphOrigin = sf::Vector2f(position.x + 8, position.y + PANEL_HEIGHT - 8);
+    
+    // 60 FPS budget marker
+    float budgetY = graphOrigin.y - GRAPH_HEIGHT * (FRAME_BUDGET_MS / GRAPH_MAX_MS);
+    budgetLine[0] = sf::Vertex(sf::Vector2f(graphOrigin.x, budgetY), sf::Color(255, 255, 255, 120));
+    budgetLine[1] = sf::Vertex(sf::Vector2f(graphOrigin.x + Profiler::HISTORY_SIZE, budgetY), sf::Color(255, 255, 255, 120));
+}
+
+void ProfilerOverlay::setFont(const sf::Font& font) {
+    statsText.setFont(font);
+}
+
+void ProfilerOverlay::update(const Profiler& profiler, const FramePacer* pacer, const SpriteBatch::Stats* batch) {
+    if (!visible) {
+        return;
+    }
+    
+    refreshGraph(profiler);
+    
+    // Text is reformatted a few times per second so the numbers stay readable
+    if (--framesUntilTextRefresh <= 0) {
+        refreshText(profiler, pacer, batch);
+        framesUntilTextRefresh = TEXT_REFRESH_FRAMES;
+    }
+}
+
+void ProfilerOverlay::refreshText(const Profiler& profiler, const FramePacer* pacer, const SpriteBatch::Stats* batch) {
+    char buffer[1024];
+    int length = std::snprintf(buffer, sizeof(buffer), "%-16s %7s %7s %7s\n", "phase (ms)", "min", "avg", "p99");
+    
+    for (std::size_t i = 0; i < PROFILE_PHASE_COUNT; ++i) {
+        ProfilePhase phase = static_cast<ProfilePhase>(i);
+        Profiler::PhaseStats stats = profiler.getPhaseStats(phase);
+        length += std::snprintf(buffer + length, sizeof(buffer) - length, "%-16s %7.3f %7.3f %7.3f\n",
+                                Profiler::phaseName(phase), stats.minMs, stats.avgMs, stats.p99Ms);
+    }
+    
+    Profiler::PhaseStats frameStats = profiler.getFrameStats();
+    length += std::snprintf(buffer + length, sizeof(buffer) - length, "%-16s %7.3f %7.3f %7.3f\n",
+                            "Frame", frameStats.minMs, frameStats.avgMs, frameStats.p99Ms);
+    length += std::snprintf(buffer + length, sizeof(buffer) - length, "CPU %.1f%%, rendered %zu/%zu frames",
+                            profiler.getCpuUsage() * 100.0f, profiler.getRenderedFrames(), profiler.size());
+    
+    if (pacer) {
+        FramePacer::Stats pacing = pacer->getStats();
+        length += std::snprintf(buffer + length, sizeof(buffer) - length, "\nPacing error     avg %.3f p99 %.3f max %.3f missed %llu",
+                                pacing.meanErrorMs, pacing.p99ErrorMs, pacing.maxErrorMs,
+                                static_cast<unsigned long long>(pacing.missedDeadlines));
+    }
+    
+    if (batch) {
+        length += std::snprintf(buffer + length, sizeof(buffer) - length, "\nBatch            %zu items, %zu draws, %zu verts, %zu states",
+                                batch->items, batch->drawCalls, batch->vertices, batch->stateChanges);
+    }
+    
+    // setString(buffer) would build a temporary sf::String every refresh;
+    // the text is ASCII, so copy it into the reused one instead
+    statsString.clear();
+    length = std::min(length, static_cast<int>(sizeof(buffer)) - 1);
+    for (int i = 0; i < length; ++i) {
+        statsString += sf::String(static_cast<sf::Uint32>(static_cast<unsigned char>(buffer[i])));
+    }
+    statsText.setString(statsString);
+}
+
+void ProfilerOverlay::refreshGraph(const Profiler& profiler) {
+    std::size_t count = profiler.size();
+    std::size_t offset = Profiler::HISTORY_SIZE - count;
+    
+    for (std::size_t i = 0; i < Profiler::HISTORY_SIZE; ++i) {
+        float frameMs = i < offset ? 0 : profiler.frame(i - offset).frameMs;
+        bool rendered = i < offset || profiler.frame(i - offset).rendered;
+        float height = GRAPH_HEIGHT * std::min(1.0f, frameMs / GRAPH_MAX_MS);
+        sf::Color color = frameMs > FRAME_BUDGET_MS ? sf::Color(230, 80, 60) : sf::Color(90, 200, 120);
+        if (!rendered) {
+            color = sf::Color(120, 120, 120);
+        }
+        
+        float left = graphOrigin.x + i;
+        sf::Vertex* quad = &graph[i * 4];
+        quad[0] = sf::Vertex(sf::Vector2f(left, graphOrigin.y - height), color);
+        quad[1] = sf::Vertex(sf::Vector2f(left + 1, graphOrigin.y - height), color);
+        quad[2] = sf::Vertex(sf::Vector2f(left + 1, graphOrigin.y), color);
+        quad[3] = sf::Vertex(sf::Vector2f(left, graphOrigin.y), color);
+    }
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (!visible) {
+        return;
+    }
+    
+    target.draw(panel, states);
+    target.draw(statsText, states);
+    target.draw(graph, states);
+    target.draw(budgetLine, states);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Profiler.h"
+#include "../core/FramePacer.h"
+#include "../graphics/SpriteBatch.h"
+
+// On-screen view of the Profiler history: min/avg/p99 per phase and a
+// frame-time graph. All vertex storage is sized once in the constructor,
+// and the stats text is rebuilt in place, so refreshing allocates nothing
+// once the buffers have grown.
+class ProfilerOverlay : public sf::Drawable {
+private:
+    sf::RectangleShape panel;
+    sf::Text statsText;
+    sf::String statsString; // Reused so refreshText keeps its capacity
+    sf::VertexArray graph;
+    sf::VertexArray budgetLine;
+    sf::Vector2f graphOrigin;
+    bool visible;
+    int framesUntilTextRefresh;
+    
+    void refreshText(const Profiler& profiler, const FramePacer* pacer, const SpriteBatch::Stats* batch);
+    void refreshGraph(const Profiler& profiler);
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    explicit ProfilerOverlay(sf::Vector2f position = sf::Vector2f(10, 10));
+    
+    void setFont(const sf::Font& font);
+    void toggle() { visible = !visible; framesUntilTextRefresh = 0; }
+    bool isVisible() const { return visible; }
+    
+    void update(const Profiler& profiler, const FramePacer* pacer = nullptr, const SpriteBatch::Stats* batch = nullptr);
+};
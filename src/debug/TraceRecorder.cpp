@@ -0,0 +1,173 @@
+#include "TraceRecorder.h"
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+
+namespace {
+    const std::chrono::milliseconds WRITER_INTERVAL(20);
+    
+    void writeEscaped(std::ofstream& output, const char* text) {
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"' || *c == '\\') {
+                output.put('\\');
+            }
+            output.put(*c);
+        }
+    }
+}
+
+TraceRecorder::TraceRecorder() : capturing(false), toggleRequested(false), droppedEvents(0), captureStartNs(0), stopRequested(false), writtenEvents(0) {
+}
+
+TraceRecorder::~TraceRecorder() {
+    stop();
+}
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+std::int64_t TraceRecorder::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::localBuffer() {
+    // Registration takes the lock once per thread, recording never does
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<std::uint32_t>(buffers.size() + 1)));
+        buffer = buffers.back().get();
+    }
+    return *buffer;
+}
+
+void TraceRecorder::record(const char* name, char phase) {
+    ThreadBuffer& buffer = localBuffer();
+    std::size_t head = buffer.head.load(std::memory_order_relaxed);
+    std::size_t tail = buffer.tail.load(std::memory_order_acquire);
+    
+    // Never block the producer; the writer will report what was lost
+    if (head - tail >= BUFFER_CAPACITY) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    Event& event = buffer.events[head % BUFFER_CAPACITY];
+    event.name = name;
+    event.timestampNs = nowNs() - captureStartNs.load(std::memory_order_relaxed);
+    event.phase = phase;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+bool TraceRecorder::start(const std::string& path) {
+    if (isCapturing()) {
+        return true;
+    }
+    
+    output.open(path, std::ios::out | std::ios::trunc);
+    if (!output) {
+        std::cout << "Warning: Could not open trace file " << path << "\n";
+        return false;
+    }
+    
+    outputPath = path;
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    output << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"OPMON Red\"}}";
+    writtenEvents = 0;
+    droppedEvents.store(0);
+    
+    // Discard anything recorded after the previous capture stopped
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        for (auto& buffer : buffers) {
+            buffer->tail.store(buffer->head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+    }
+    
+    captureStartNs.store(nowNs(), std::memory_order_relaxed);
+    stopRequested = false;
+    capturing.store(true, std::memory_order_release);
+    writerThread = std::thread(&TraceRecorder::writerLoop, this);
+    return true;
+}
+
+void TraceRecorder::stop() {
+    if (!isCapturing()) {
+        return;
+    }
+    
+    capturing.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopRequested = true;
+    }
+    writerWake.notify_one();
+    writerThread.join();
+    
+    // Final drain picks up everything recorded before capturing was cleared
+    drain();
+    output << "\n]}\n";
+    output.close();
+    
+    std::cout << "Trace written to " << outputPath << " (" << writtenEvents << " events";
+    std::uint64_t dropped = droppedEvents.load();
+    if (dropped > 0) {
+        std::cout << ", " << dropped << " dropped";
+    }
+    std::cout << ")\n";
+}
+
+void TraceRecorder::beginFrame() {
+    if (toggleRequested.load(std::memory_order_relaxed) && toggleRequested.exchange(false, std::memory_order_relaxed)) {
+        if (isCapturing()) {
+            stop();
+        } else {
+            start(defaultFileName());
+        }
+    }
+    begin("Frame");
+}
+
+void TraceRecorder::writerLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (!stopRequested) {
+        writerWake.wait_for(lock, WRITER_INTERVAL, [this]() { return stopRequested; });
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void TraceRecorder::drain() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto& buffer : buffers) {
+        std::size_t tail = buffer->tail.load(std::memory_order_relaxed);
+        std::size_t head = buffer->head.load(std::memory_order_acquire);
+        
+        for (; tail != head; ++tail) {
+            writeEvent(buffer->events[tail % BUFFER_CAPACITY], buffer->threadId);
+        }
+        buffer->tail.store(tail, std::memory_order_release);
+    }
+    output.flush();
+}
+
+void TraceRecorder::writeEvent(const Event& event, std::uint32_t threadId) {
+    char timestamp[32];
+    std::snprintf(timestamp, sizeof(timestamp), "%.3f", event.timestampNs / 1000.0);
+    
+    output << ",\n{\"name\":\"";
+    writeEscaped(output, event.name);
+    output << "\",\"ph\":\"" << event.phase << "\",\"ts\":" << timestamp
+           << ",\"pid\":1,\"tid\":" << threadId << "}";
+    ++writtenEvents;
+}
+
+std::string TraceRecorder::defaultFileName() {
+    std::time_t now = std::time(nullptr);
+    char name[64];
+    std::strftime(name, sizeof(name), "opmon_trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+    return name;
+}
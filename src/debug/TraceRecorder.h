@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Records nested begin/end events into per-thread ring buffers and streams
+// them to a chrome://tracing / Perfetto compatible JSON file from a
+// background writer thread. Event names must be string literals (or
+// otherwise outlive the capture), only the pointer is stored.
+class TraceRecorder {
+public:
+    static constexpr std::size_t BUFFER_CAPACITY = 1 << 16;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    
+    struct Event {
+        const char* name;
+        std::int64_t timestampNs;
+        char phase;
+    };
+    
+    // Single producer (the owning thread), single consumer (the writer)
+    struct ThreadBuffer {
+        Event events[BUFFER_CAPACITY];
+        std::atomic<std::size_t> head;
+        std::atomic<std::size_t> tail;
+        std::uint32_t threadId;
+        
+        explicit ThreadBuffer(std::uint32_t id) : head(0), tail(0), threadId(id) {}
+    };
+    
+    std::atomic<bool> capturing;
+    std::atomic<bool> toggleRequested;
+    std::atomic<std::uint64_t> droppedEvents;
+    // Clock time the capture started, in nanoseconds; read by every
+    // recording thread
+    std::atomic<std::int64_t> captureStartNs;
+    
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    
+    std::thread writerThread;
+    std::mutex writerMutex;
+    std::condition_variable writerWake;
+    bool stopRequested;
+    std::ofstream output;
+    std::string outputPath;
+    std::uint64_t writtenEvents;
+    
+    static std::int64_t nowNs();
+    ThreadBuffer& localBuffer();
+    void record(const char* name, char phase);
+    void writerLoop();
+    void drain();
+    void writeEvent(const Event& event, std::uint32_t threadId);
+
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+    
+    static TraceRecorder& instance();
+    
+    bool start(const std::string& path);
+    void stop();
+    bool isCapturing() const { return capturing.load(std::memory_order_acquire); }
+    const std::string& getOutputPath() const { return outputPath; }
+    
+    void begin(const char* name) { if (isCapturing()) record(name, 'B'); }
+    void end(const char* name) { if (isCapturing()) record(name, 'E'); }
+    
+    // Starts or stops a capture at the next beginFrame, so the trace never
+    // holds half of a begin/end pair
+    void requestToggle() { toggleRequested.store(true, std::memory_order_relaxed); }
+    // Applies a pending toggle, then opens the "Frame" event
+    void beginFrame();
+    
+    // Builds a timestamped file name such as opmon_trace_20250101_120000.json
+    static std::string defaultFileName();
+};
+
+class TraceScope {
+private:
+    const char* name;
+
+public:
+    explicit TraceScope(const char* scopeName) : name(scopeName) {
+        TraceRecorder::instance().begin(name);
+    }
+    
+    ~TraceScope() {
+        TraceRecorder::instance().end(name);
+    }
+    
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
@@ -0,0 +1,112 @@
+#include "ConditionCache.h"
+#include <algorithm>
+
+ConditionCache::ConditionCache(const DialogueProgram& compiled, const DialogueHost& state)
+    : program(compiled), host(state), evaluationCount(0) {
+    rebuild();
+}
+
+void ConditionCache::rebuild() {
+    std::size_t conditionCount = program.conditions.size();
+    results.assign(conditionCount, 0);
+    conditionNode.assign(conditionCount, 0);
+    selectedLines.assign(program.nodes.size(), DialogueRunner::NO_LINE);
+    nodeDirty.assign(program.nodes.size(), 1);
+    locationDependents.clear();
+    
+    for (std::uint32_t node = 0; node < program.nodes.size(); ++node) {
+        const DialogueNodeCode& code = program.nodes[node];
+        for (std::uint32_t line = code.lineBegin; line < code.lineBegin + code.lineCount; ++line) {
+            const DialogueLineCode& lineCode = program.lines[line];
+            for (std::uint32_t c = lineCode.conditionBegin; c < lineCode.conditionBegin + lineCode.conditionCount; ++c) {
+                conditionNode[c] = node;
+            }
+        }
+    }
+    
+    // Counting sort of the conditions by the variable they read
+    std::uint32_t variableCount = 0;
+    for (const DialogueCondition& condition : program.conditions) {
+        if (condition.op != ConditionOp::AtLocation && condition.variable.isValid()) {
+            variableCount = std::max(variableCount, condition.variable.index + 1);
+        }
+    }
+    dependencyBegin.assign(variableCount + 1, 0);
+    for (const DialogueCondition& condition : program.conditions) {
+        if (condition.op != ConditionOp::AtLocation && condition.variable.isValid()) {
+            ++dependencyBegin[condition.variable.index + 1];
+        }
+    }
+    for (std::uint32_t i = 0; i < variableCount; ++i) {
+        dependencyBegin[i + 1] += dependencyBegin[i];
+    }
+    dependents.assign(dependencyBegin[variableCount], 0);
+    std::vector<std::uint32_t> cursor(dependencyBegin.begin(), dependencyBegin.end() - 1);
+    for (std::uint32_t c = 0; c < conditionCount; ++c) {
+        const DialogueCondition& condition = program.conditions[c];
+        if (condition.op == ConditionOp::AtLocation) {
+            locationDependents.push_back(c);
+        } else if (condition.variable.isValid()) {
+            dependents[cursor[condition.variable.index]++] = c;
+        }
+        
+        results[c] = DialogueRunner::evaluate(condition, host);
+        ++evaluationCount;
+    }
+}
+
+void ConditionCache::update(std::uint32_t condition) {
+    std::uint8_t result = DialogueRunner::evaluate(program.conditions[condition], host);
+    ++evaluationCount;
+    if (result != results[condition]) {
+        results[condition] = result;
+        nodeDirty[conditionNode[condition]] = 1;
+    }
+}
+
+void ConditionCache::invalidate(StringId variable) {
+    // Ids nothing depends on, including invalid ones from a failed find()
+    if (!variable.isValid() || variable.index >= dependencyBegin.size() - 1) {
+        return;
+    }
+    for (std::uint32_t i = dependencyBegin[variable.index]; i < dependencyBegin[variable.index + 1]; ++i) {
+        update(dependents[i]);
+    }
+}
+
+void ConditionCache::invalidate(const std::vector<StringId>& variables) {
+    for (StringId variable : variables) {
+        invalidate(variable);
+    }
+}
+
+void ConditionCache::invalidateLocation() {
+    for (std::uint32_t condition : locationDependents) {
+        update(condition);
+    }
+}
+
+bool ConditionCache::linePasses(const DialogueLineCode& line) const {
+    for (std::uint32_t c = line.conditionBegin; c < line.conditionBegin + line.conditionCount; ++c) {
+        if (!results[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint32_t ConditionCache::selectLine(std::uint32_t node) {
+    if (nodeDirty[node]) {
+        const DialogueNodeCode& code = program.nodes[node];
+        std::uint32_t selected = DialogueRunner::NO_LINE;
+        for (std::uint32_t i = code.lineBegin + code.lineCount; i-- > code.lineBegin;) {
+            if (linePasses(program.lines[i])) {
+                selected = i;
+                break;
+            }
+        }
+        selectedLines[node] = selected;
+        nodeDirty[node] = 0;
+    }
+    return selectedLines[node];
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "DialogueRunner.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Cached results of every condition in a DialogueProgram, and of the line
+// each node would show. A dependency index maps each state variable (flag,
+// crew_size, quest, ...) to the conditions reading it, so when a variable
+// changes only those conditions are evaluated again, and only nodes whose
+// conditions actually flipped pick their line again.
+//
+// The cache does not watch the host: whoever changes a variable reports it
+// through invalidate(), e.g. from a FlagStore listener:
+//
+//     flags.subscribe([&](const FlagStore&, const std::vector<StringId>& changed) {
+//         conditions.invalidate(changed);
+//     });
+//
+// That flush only runs at the end of the tick, so a DialogueRunner using
+// the cache also invalidates what its own actions change before it picks
+// the next node's line.
+class ConditionCache {
+private:
+    const DialogueProgram& program;
+    const DialogueHost& host;
+    std::vector<std::uint8_t> results;             // By condition
+    std::vector<std::uint32_t> conditionNode;      // Node owning each condition
+    std::vector<std::uint32_t> selectedLines;      // By node
+    std::vector<std::uint8_t> nodeDirty;
+    std::vector<std::uint32_t> dependencyBegin;    // By variable index, into dependents
+    std::vector<std::uint32_t> dependents;
+    std::vector<std::uint32_t> locationDependents;
+    std::size_t evaluationCount;
+    
+    void update(std::uint32_t condition);
+    bool linePasses(const DialogueLineCode& line) const;
+
+public:
+    // The program and host must outlive the cache
+    ConditionCache(const DialogueProgram& compiled, const DialogueHost& state);
+    
+    // Builds the dependency index and evaluates every condition; call again
+    // after recompiling the program
+    void rebuild();
+    
+    // Re-evaluates the conditions reading variable
+    void invalidate(StringId variable);
+    void invalidate(const std::vector<StringId>& variables);
+    // Re-evaluates the conditions on the player's location
+    void invalidateLocation();
+    
+    bool isTrue(std::uint32_t condition) const { return results[condition] != 0; }
+    // Last line of the node whose conditions all hold, or DialogueRunner::NO_LINE
+    std::uint32_t selectLine(std::uint32_t node);
+    
+    // Conditions evaluated since construction, including rebuilds
+    std::size_t getEvaluationCount() const { return evaluationCount; }
+};
@@ -0,0 +1,197 @@
+#include "DialogueProgram.h"
+#include "../data/ShippedIds.h"
+#include "../data/StringInterner.h"
+#include <charconv>
+#include <iostream>
+
+namespace {
+    struct ComparisonPrefix {
+        const char* text;
+        ConditionOp op;
+    };
+    
+    // Longest prefixes first
+    const ComparisonPrefix COMPARISONS[] = {
+        { ">=", ConditionOp::GreaterEqual },
+        { "<=", ConditionOp::LessEqual },
+        { "==", ConditionOp::Equal },
+        { "!=", ConditionOp::NotEqual },
+        { ">", ConditionOp::Greater },
+        { "<", ConditionOp::Less },
+        { "=", ConditionOp::Equal }
+    };
+    
+    std::uint32_t count(std::size_t end, std::uint32_t begin) {
+        return static_cast<std::uint32_t>(end) - begin;
+    }
+}
+
+bool DialogueProgram::compile(const DialogueFile& dialogue) {
+    clear();
+    
+    // Allocate every speaker's node range first so jumps can be resolved
+    // while compiling
+    for (const auto& speaker : dialogue.dialogues) {
+        DialogueSpeakerCode code = { speaker.first, static_cast<std::uint32_t>(nodes.size()),
+                                     static_cast<std::uint32_t>(speaker.second.size()) };
+        for (const auto& node : speaker.second) {
+            nodes.push_back({ node.first, 0, 0 });
+        }
+        
+        if (speaker.first.index >= speakerIndex.size()) {
+            speakerIndex.resize(speaker.first.index + 1, NO_SPEAKER);
+        }
+        speakerIndex[speaker.first.index] = static_cast<std::uint32_t>(speakers.size());
+        speakers.push_back(code);
+    }
+    
+    for (std::size_t i = 0; i < speakers.size(); ++i) {
+        const DialogueSpeakerCode& speaker = speakers[i];
+        for (std::uint32_t node = speaker.nodeBegin; node < speaker.nodeBegin + speaker.nodeCount; ++node) {
+            compileNode(speaker, dialogue.dialogues[i].second, node);
+        }
+    }
+    return warningCount == 0;
+}
+
+void DialogueProgram::compileNode(const DialogueSpeakerCode& speaker, const RecordMap<DialogueNode>& speakerNodes,
+                                  std::uint32_t nodeIndex) {
+    const DialogueNode& node = speakerNodes[nodeIndex - speaker.nodeBegin].second;
+    nodes[nodeIndex].lineBegin = static_cast<std::uint32_t>(lines.size());
+    nodes[nodeIndex].lineCount = static_cast<std::uint32_t>(node.size());
+    
+    for (const DialogueLine& line : node) {
+        DialogueLineCode lineCode;
+        lineCode.text = line.text;
+        lineCode.emotion = line.emotion;
+        
+        lineCode.conditionBegin = static_cast<std::uint32_t>(conditions.size());
+        compileConditions(speaker.speaker, line.conditions);
+        lineCode.conditionCount = count(conditions.size(), lineCode.conditionBegin);
+        
+        lineCode.actionBegin = static_cast<std::uint32_t>(actions.size());
+        compileAction(speaker.speaker, line.action, line.flag, StringId(), line.item.id, line.amount);
+        lineCode.actionCount = count(actions.size(), lineCode.actionBegin);
+        
+        lineCode.responseBegin = static_cast<std::uint32_t>(responses.size());
+        for (const DialogueResponse& response : line.responses) {
+            DialogueResponseCode responseCode;
+            responseCode.text = response.text;
+            responseCode.actionBegin = static_cast<std::uint32_t>(actions.size());
+            compileAction(speaker.speaker, response.action, response.flag, response.quest, StringId(), response.amount);
+            responseCode.actionCount = count(actions.size(), responseCode.actionBegin);
+            
+            // Dangling targets were reported by the link pass and end the conversation
+            responseCode.next = END_NODE;
+            for (std::size_t target = 0; target < speakerNodes.size(); ++target) {
+                if (speakerNodes[target].first == response.next.id) {
+                    responseCode.next = speaker.nodeBegin + static_cast<std::uint32_t>(target);
+                    break;
+                }
+            }
+            responses.push_back(responseCode);
+        }
+        lineCode.responseCount = count(responses.size(), lineCode.responseBegin);
+        
+        lines.push_back(lineCode);
+    }
+}
+
+void DialogueProgram::compileConditions(StringId speaker, const RecordMap<std::string_view>& source) {
+    StringInterner& ids = StringInterner::instance();
+    
+    for (const auto& condition : source) {
+        std::string_view value = condition.second;
+        DialogueCondition code = { ConditionOp::Never, condition.first, 0 };
+        
+        if (condition.first == ID_FLAG) {
+            code.op = ConditionOp::FlagSet;
+            code.variable = ids.intern(value);
+        } else if (condition.first == ID_LOCATION) {
+            code.op = value == "any" ? ConditionOp::Always : ConditionOp::AtLocation;
+            code.variable = ids.intern(value);
+        } else {
+            // Numeric comparison such as crew_size: ">2"; a bare number means equality
+            ConditionOp op = ConditionOp::Equal;
+            for (const ComparisonPrefix& prefix : COMPARISONS) {
+                std::string_view text(prefix.text);
+                if (value.substr(0, text.size()) == text) {
+                    op = prefix.op;
+                    value.remove_prefix(text.size());
+                    break;
+                }
+            }
+            
+            const char* end = value.data() + value.size();
+            auto result = std::from_chars(value.data(), end, code.value);
+            if (result.ec == std::errc() && result.ptr == end) {
+                code.op = op;
+            } else {
+                warn(speaker, "unsupported condition value", condition.second);
+            }
+        }
+        conditions.push_back(code);
+    }
+}
+
+void DialogueProgram::compileAction(StringId speaker, StringId action, StringId flag, StringId quest, StringId item, int amount) {
+    if (action == ID_JOIN_CREW) {
+        actions.push_back({ DialogueOp::JoinCrew, speaker, 0 });
+    } else if (action == ID_SET_FLAG) {
+        actions.push_back({ DialogueOp::SetFlag, flag, 0 });
+    } else if (action == ID_SET_QUEST) {
+        actions.push_back({ DialogueOp::SetQuest, quest, 0 });
+    } else if (action == ID_GIVE_ITEM) {
+        actions.push_back({ DialogueOp::GiveItem, item, amount > 0 ? amount : 1 });
+    } else if (action == ID_INCREASE_LOYALTY) {
+        actions.push_back({ DialogueOp::ChangeLoyalty, speaker, amount });
+    } else if (action == ID_DECREASE_LOYALTY) {
+        actions.push_back({ DialogueOp::ChangeLoyalty, speaker, -amount });
+    } else if (action == ID_END_CONVERSATION) {
+        actions.push_back({ DialogueOp::EndConversation, StringId(), 0 });
+    } else if (action.isValid() && action != ID_NONE) {
+        warn(speaker, "unknown action", StringInterner::instance().name(action));
+    }
+    
+    // A flag next to another action is set alongside it
+    if (flag.isValid() && action != ID_SET_FLAG) {
+        actions.push_back({ DialogueOp::SetFlag, flag, 0 });
+    }
+}
+
+void DialogueProgram::warn(StringId speaker, const char* message, std::string_view detail) {
+    std::cout << "Warning: dialogue: " << StringInterner::instance().name(speaker) << ": " << message << " '" << detail
+              << "'" << std::endl;
+    ++warningCount;
+}
+
+void DialogueProgram::clear() {
+    speakerIndex.clear();
+    warningCount = 0;
+    speakers.clear();
+    nodes.clear();
+    lines.clear();
+    responses.clear();
+    actions.clear();
+    conditions.clear();
+}
+
+const DialogueSpeakerCode* DialogueProgram::findSpeaker(StringId speaker) const {
+    if (speaker.index >= speakerIndex.size() || speakerIndex[speaker.index] == NO_SPEAKER) {
+        return nullptr;
+    }
+    return &speakers[speakerIndex[speaker.index]];
+}
+
+std::uint32_t DialogueProgram::findNode(StringId speaker, StringId node) const {
+    const DialogueSpeakerCode* code = findSpeaker(speaker);
+    if (!code) {
+        return END_NODE;
+    }
+    for (std::uint32_t i = code->nodeBegin; i < code->nodeBegin + code->nodeCount; ++i) {
+        if (nodes[i].name == node) {
+            return i;
+        }
+    }
+    return END_NODE;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "../data/GameRecords.h"
+#include "../data/StringId.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Dialogue compiled from dialogue/characters.json into flat arrays. Nodes,
+// lines, responses, actions and conditions each live in one vector and
+// refer to each other by index, jump targets are node indices, actions are
+// opcodes and conditions are pre-parsed comparisons. Text points into the
+// GameData the program was compiled from, which must outlive it.
+
+enum class DialogueOp : std::uint8_t {
+    JoinCrew,         // The speaker joins the crew
+    SetFlag,          // argument: flag
+    SetQuest,         // argument: quest
+    GiveItem,         // argument: item
+    ChangeLoyalty,    // amount: signed change of the speaker's loyalty
+    EndConversation
+};
+
+struct DialogueAction {
+    DialogueOp op;
+    StringId argument;
+    std::int32_t amount;
+};
+
+enum class ConditionOp : std::uint8_t {
+    Always,
+    Never,            // Conditions the compiler did not understand
+    FlagSet,          // variable: flag
+    AtLocation,       // variable: location
+    Less,             // variable: stat such as crew_size, compared with value
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual
+};
+
+struct DialogueCondition {
+    ConditionOp op;
+    StringId variable;
+    std::int64_t value;
+};
+
+struct DialogueResponseCode {
+    std::string_view text;
+    std::uint32_t actionBegin;
+    std::uint32_t actionCount;
+    std::uint32_t next; // Node index, or END_NODE
+};
+
+struct DialogueLineCode {
+    std::string_view text;
+    StringId emotion;
+    std::uint32_t conditionBegin;
+    std::uint32_t conditionCount;
+    std::uint32_t actionBegin;    // Run when the line is shown
+    std::uint32_t actionCount;
+    std::uint32_t responseBegin;
+    std::uint32_t responseCount;
+};
+
+// A node holds alternative lines; the runner shows the last one whose
+// conditions all hold, so later lines specialise the first
+struct DialogueNodeCode {
+    StringId name;
+    std::uint32_t lineBegin;
+    std::uint32_t lineCount;
+};
+
+struct DialogueSpeakerCode {
+    StringId speaker;
+    std::uint32_t nodeBegin;
+    std::uint32_t nodeCount;
+};
+
+class DialogueProgram {
+private:
+    std::vector<std::uint32_t> speakerIndex; // By StringId, NO_SPEAKER when absent
+    std::size_t warningCount = 0;
+    
+    void compileNode(const DialogueSpeakerCode& speaker, const RecordMap<DialogueNode>& speakerNodes, std::uint32_t nodeIndex);
+    void compileConditions(StringId speaker, const RecordMap<std::string_view>& conditions);
+    void compileAction(StringId speaker, StringId action, StringId flag, StringId quest, StringId item, int amount);
+    void warn(StringId speaker, const char* message, std::string_view detail);
+
+public:
+    static constexpr std::uint32_t END_NODE = 0xFFFFFFFFu;
+    static constexpr std::uint32_t NO_SPEAKER = 0xFFFFFFFFu;
+    
+    std::vector<DialogueSpeakerCode> speakers;
+    std::vector<DialogueNodeCode> nodes;
+    std::vector<DialogueLineCode> lines;
+    std::vector<DialogueResponseCode> responses;
+    std::vector<DialogueAction> actions;
+    std::vector<DialogueCondition> conditions;
+    
+    // Replaces the program; returns false if anything was skipped
+    bool compile(const DialogueFile& dialogue);
+    void clear();
+    
+    const DialogueSpeakerCode* findSpeaker(StringId speaker) const;
+    // Index of the speaker's node, or END_NODE (linear over that speaker's nodes)
+    std::uint32_t findNode(StringId speaker, StringId node) const;
+    
+    std::size_t getWarningCount() const { return warningCount; }
+};
@@ -0,0 +1,139 @@
+#include "DialogueRunner.h"
+#include "ConditionCache.h"
+#include "../data/ShippedIds.h"
+
+DialogueRunner::DialogueRunner(const DialogueProgram& compiled, DialogueHost& state, ConditionCache* conditionCache)
+    : program(compiled), host(state), cache(conditionCache), line(NO_LINE), closing(false) {
+}
+
+bool DialogueRunner::evaluate(const DialogueCondition& condition, const DialogueHost& state) {
+    switch (condition.op) {
+        case ConditionOp::Always:
+            return true;
+        case ConditionOp::FlagSet:
+            return state.isFlagSet(condition.variable);
+        case ConditionOp::AtLocation:
+            return state.getLocation() == condition.variable;
+        case ConditionOp::Less:
+            return state.getValue(condition.variable) < condition.value;
+        case ConditionOp::LessEqual:
+            return state.getValue(condition.variable) <= condition.value;
+        case ConditionOp::Greater:
+            return state.getValue(condition.variable) > condition.value;
+        case ConditionOp::GreaterEqual:
+            return state.getValue(condition.variable) >= condition.value;
+        case ConditionOp::Equal:
+            return state.getValue(condition.variable) == condition.value;
+        case ConditionOp::NotEqual:
+            return state.getValue(condition.variable) != condition.value;
+        default:
+            return false;
+    }
+}
+
+bool DialogueRunner::run(std::uint32_t actionBegin, std::uint32_t actionCount) {
+    bool continues = true;
+    for (std::uint32_t i = actionBegin; i < actionBegin + actionCount; ++i) {
+        const DialogueAction& action = program.actions[i];
+        if (action.op == DialogueOp::EndConversation) {
+            continues = false;
+            continue;
+        }
+        
+        host.perform(action, speaker);
+        // The next node may test what this action changed, before any
+        // FlagStore flush reaches the cache
+        if (cache) {
+            switch (action.op) {
+                case DialogueOp::SetFlag:
+                case DialogueOp::SetQuest:
+                case DialogueOp::GiveItem:
+                    cache->invalidate(action.argument);
+                    break;
+                case DialogueOp::JoinCrew:
+                    cache->invalidate(ID_CREW_SIZE);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    return continues;
+}
+
+void DialogueRunner::enter(std::uint32_t node) {
+    line = NO_LINE;
+    closing = false;
+    if (node == DialogueProgram::END_NODE) {
+        return;
+    }
+    
+    if (cache) {
+        line = cache->selectLine(node);
+    } else {
+        // The last line whose conditions all hold
+        const DialogueNodeCode& code = program.nodes[node];
+        for (std::uint32_t i = code.lineBegin + code.lineCount; i-- > code.lineBegin;) {
+            const DialogueLineCode& candidate = program.lines[i];
+            bool matches = true;
+            for (std::uint32_t c = candidate.conditionBegin; c < candidate.conditionBegin + candidate.conditionCount && matches; ++c) {
+                matches = evaluate(program.conditions[c], host);
+            }
+            if (matches) {
+                line = i;
+                break;
+            }
+        }
+    }
+    
+    if (line != NO_LINE) {
+        closing = !run(program.lines[line].actionBegin, program.lines[line].actionCount);
+    }
+}
+
+bool DialogueRunner::start(StringId speakerId, StringId node) {
+    std::uint32_t index = program.findNode(speakerId, node);
+    if (index == DialogueProgram::END_NODE) {
+        line = NO_LINE;
+        return false;
+    }
+    
+    speaker = speakerId;
+    enter(index);
+    return isActive();
+}
+
+const DialogueLineCode* DialogueRunner::getLine() const {
+    return line != NO_LINE ? &program.lines[line] : nullptr;
+}
+
+std::size_t DialogueRunner::getResponseCount() const {
+    return line != NO_LINE && !closing ? program.lines[line].responseCount : 0;
+}
+
+std::string_view DialogueRunner::getResponseText(std::size_t response) const {
+    if (response >= getResponseCount()) {
+        return std::string_view();
+    }
+    return program.responses[program.lines[line].responseBegin + response].text;
+}
+
+bool DialogueRunner::choose(std::size_t response) {
+    if (response >= getResponseCount()) {
+        return false;
+    }
+    
+    const DialogueResponseCode& code = program.responses[program.lines[line].responseBegin + response];
+    if (run(code.actionBegin, code.actionCount)) {
+        enter(code.next);
+    } else {
+        line = NO_LINE;
+    }
+    return true;
+}
+
+void DialogueRunner::advance() {
+    if (getResponseCount() == 0) {
+        line = NO_LINE;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "DialogueProgram.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Game state that dialogue reads and changes
+class DialogueHost {
+public:
+    virtual ~DialogueHost() = default;
+    
+    virtual bool isFlagSet(StringId flag) const = 0;
+    // Numeric state such as crew_size, level or berry_amount
+    virtual std::int64_t getValue(StringId variable) const = 0;
+    virtual StringId getLocation() const = 0;
+    
+    // Every opcode except EndConversation, which the runner handles. With a
+    // ConditionCache, the runner invalidates the action's argument (and
+    // crew_size for JoinCrew) itself; any other variable perform() changes
+    // must be passed to ConditionCache::invalidate before it returns.
+    virtual void perform(const DialogueAction& action, StringId speaker) = 0;
+};
+
+class ConditionCache;
+
+// Steps through one conversation of a compiled DialogueProgram. Each step
+// reads a bounded number of program entries and never allocates.
+class DialogueRunner {
+private:
+    const DialogueProgram& program;
+    DialogueHost& host;
+    ConditionCache* cache;
+    StringId speaker;
+    std::uint32_t line;
+    bool closing; // The line's actions ended the conversation; it offers no responses
+    
+    // Runs actions; returns false if one of them ends the conversation
+    bool run(std::uint32_t actionBegin, std::uint32_t actionCount);
+    void enter(std::uint32_t node);
+
+public:
+    static constexpr std::uint32_t NO_LINE = 0xFFFFFFFFu;
+    
+    // With a cache, lines are picked from its cached condition results
+    // instead of evaluating every condition of the node
+    DialogueRunner(const DialogueProgram& compiled, DialogueHost& state, ConditionCache* conditionCache = nullptr);
+    
+    static bool evaluate(const DialogueCondition& condition, const DialogueHost& state);
+    
+    // Shows the node's line; false if the speaker or node does not exist
+    bool start(StringId speakerId, StringId node);
+    void stop() { line = NO_LINE; }
+    bool isActive() const { return line != NO_LINE; }
+    
+    StringId getSpeaker() const { return speaker; }
+    // nullptr once the conversation has ended
+    const DialogueLineCode* getLine() const;
+    std::size_t getResponseCount() const;
+    std::string_view getResponseText(std::size_t response) const;
+    
+    // Runs the response's actions and moves to its target node; false if
+    // response is out of range
+    bool choose(std::size_t response);
+    // Continues past a line without responses, which ends the conversation
+    void advance();
+};
@@ -0,0 +1,141 @@
+#include "EncounterTables.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+EncounterTables::EncounterTables(const LocationFile& locations) {
+    for (const auto& location : locations.locations) {
+        build(location.first, location.second);
+    }
+}
+
+const EncounterTables::Table* EncounterTables::findTable(StringId location) const {
+    if (location.index >= tables.size() || tables[location.index].count == 0) {
+        return nullptr;
+    }
+    return &tables[location.index];
+}
+
+void EncounterTables::build(StringId location, const Location& record) {
+    std::vector<double> weights;
+    std::uint32_t begin = static_cast<std::uint32_t>(groups.size());
+    double totalRate = 0;
+    for (const RandomEncounter& encounter : record.randomEncounters) {
+        std::size_t nonEmpty = 0;
+        for (const EnemyGroup& group : encounter.enemyGroups) {
+            nonEmpty += group.empty() ? 0 : 1;
+        }
+        if (nonEmpty == 0 || encounter.encounterRate <= 0) {
+            continue;
+        }
+        totalRate += encounter.encounterRate;
+        for (const EnemyGroup& group : encounter.enemyGroups) {
+            if (!group.empty()) {
+                groups.push_back(&group);
+                weights.push_back(encounter.encounterRate / nonEmpty);
+            }
+        }
+    }
+    if (weights.empty()) {
+        return;
+    }
+    if (totalRate > 1) {
+        std::cout << "Warning: locations: " << StringInterner::instance().name(location)
+                  << " has encounter rates adding up to more than 1" << std::endl;
+    }
+    
+    Table table;
+    table.begin = begin;
+    table.count = static_cast<std::uint32_t>(weights.size());
+    table.rate = static_cast<float>(std::min(totalRate, 1.0));
+    table.stepScale = table.rate < 1 ? static_cast<float>(1 / std::log1p(-static_cast<double>(table.rate))) : 0;
+    
+    // Vose: scale the weights to average 1, then pair each column below 1
+    // with one above it that tops it up
+    std::size_t count = weights.size();
+    probability.resize(begin + count);
+    alias.resize(begin + count);
+    std::vector<double> scaled(count);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        scaled[i] = weights[i] * count / totalRate;
+        (scaled[i] < 1 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        std::uint32_t less = small.back();
+        std::uint32_t more = large.back();
+        small.pop_back();
+        large.pop_back();
+        probability[begin + less] = static_cast<float>(scaled[less]);
+        alias[begin + less] = more;
+        scaled[more] = (scaled[more] + scaled[less]) - 1;
+        (scaled[more] < 1 ? small : large).push_back(more);
+    }
+    // Whatever is left is 1 up to rounding
+    for (std::uint32_t i : large) {
+        probability[begin + i] = 1;
+        alias[begin + i] = i;
+    }
+    for (std::uint32_t i : small) {
+        probability[begin + i] = 1;
+        alias[begin + i] = i;
+    }
+    
+    if (location.index >= tables.size()) {
+        tables.resize(location.index + 1);
+    }
+    tables[location.index] = table;
+}
+
+float EncounterTables::getRate(StringId location) const {
+    const Table* table = findTable(location);
+    return table ? table->rate : 0;
+}
+
+std::size_t EncounterTables::getGroupCount(StringId location) const {
+    const Table* table = findTable(location);
+    return table ? table->count : 0;
+}
+
+std::uint32_t EncounterTables::sampleSteps(StringId location, Random& random) const {
+    const Table* table = findTable(location);
+    if (!table) {
+        return NEVER;
+    }
+    if (table->rate >= 1) {
+        return 1;
+    }
+    
+    // Inverse of the geometric distribution; 1 - u keeps log away from 0
+    float u = 1 - random.nextFloat();
+    float steps = std::log(u) * table->stepScale;
+    return steps < static_cast<float>(NEVER - 2) ? static_cast<std::uint32_t>(steps) + 1 : NEVER - 1;
+}
+
+const EnemyGroup* EncounterTables::sampleGroup(StringId location, Random& random) const {
+    const Table* table = findTable(location);
+    if (!table) {
+        return nullptr;
+    }
+    
+    std::uint32_t column = random.nextBelow(table->count);
+    if (random.nextFloat() >= probability[table->begin + column]) {
+        column = alias[table->begin + column];
+    }
+    return groups[table->begin + column];
+}
+
+EncounterCountdown::EncounterCountdown(const EncounterTables& tables)
+    : tables(tables), stepsLeft(EncounterTables::NEVER) {
+}
+
+void EncounterCountdown::enter(StringId location, Random& random) {
+    this->location = location;
+    stepsLeft = tables.sampleSteps(location, random);
+}
+
+const EnemyGroup* EncounterCountdown::encounter(Random& random) {
+    stepsLeft = tables.sampleSteps(location, random);
+    return tables.sampleGroup(location, random);
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "../data/GameRecords.h"
+#include "Random.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using EnemyGroup = std::vector<Ref<Character>>;
+
+// Random encounters of every location, built once at load time.
+//
+// Each location's randomEncounters entries are merged into one table: the
+// chance of an encounter per step is the sum of their encounterRates
+// (capped at 1), and an entry's rate is shared evenly by its enemy groups.
+// Groups are picked with Vose's alias method, so a roll is one random
+// number and one or two loads however many groups a region has. Instead of
+// rolling on every step, sampleSteps() draws the number of steps until the
+// next encounter from the matching geometric distribution; see
+// EncounterCountdown.
+class EncounterTables {
+private:
+    struct Table {
+        std::uint32_t begin = 0; // Into probability, alias and groups
+        std::uint32_t count = 0;
+        float rate = 0;          // Per step
+        float stepScale = 0;     // 1 / log(1 - rate)
+    };
+    
+    std::vector<Table> tables; // By location StringId index
+    std::vector<float> probability;
+    std::vector<std::uint32_t> alias;
+    std::vector<const EnemyGroup*> groups;
+    
+    const Table* findTable(StringId location) const;
+    void build(StringId location, const Location& record);
+
+public:
+    // sampleSteps() result for locations without encounters
+    static constexpr std::uint32_t NEVER = 0xFFFFFFFFu;
+    
+    explicit EncounterTables(const LocationFile& locations);
+    
+    bool hasEncounters(StringId location) const { return findTable(location) != nullptr; }
+    float getRate(StringId location) const;
+    std::size_t getGroupCount(StringId location) const;
+    
+    // Steps until the next encounter, at least 1, or NEVER
+    std::uint32_t sampleSteps(StringId location, Random& random) const;
+    // The group met once an encounter happens; nullptr without encounters
+    const EnemyGroup* sampleGroup(StringId location, Random& random) const;
+};
+
+// Overworld side of the tables: draws the steps to the next encounter on
+// entering a location and after each encounter, so a step without one is
+// a single decrement.
+class EncounterCountdown {
+private:
+    const EncounterTables& tables;
+    StringId location;
+    std::uint32_t stepsLeft;
+    
+    const EnemyGroup* encounter(Random& random);
+
+public:
+    explicit EncounterCountdown(const EncounterTables& tables);
+    
+    void enter(StringId location, Random& random);
+    // The group met on this step, or nullptr
+    const EnemyGroup* step(Random& random) {
+        if (stepsLeft == EncounterTables::NEVER || --stepsLeft > 0) {
+            return nullptr;
+        }
+        return encounter(random);
+    }
+    
+    std::uint32_t getStepsLeft() const { return stepsLeft; }
+};
@@ -0,0 +1,116 @@
+#include "FlagStore.h"
+#include "../data/BitOps.h"
+#include <algorithm>
+#include <utility>
+
+void FlagStore::markChanged(std::uint32_t index) {
+    std::uint32_t word = index / 64;
+    std::uint64_t bit = std::uint64_t(1) << (index % 64);
+    if (word >= pendingWords.size()) {
+        pendingWords.resize(word + 1, 0);
+    }
+    if ((pendingWords[word] & bit) == 0) {
+        pendingWords[word] |= bit;
+        pending.push_back(StringId(index));
+    }
+}
+
+bool FlagStore::set(StringId flag, bool value) {
+    if (!flag.isValid()) {
+        return false;
+    }
+    std::uint32_t word = flag.index / 64;
+    std::uint64_t bit = std::uint64_t(1) << (flag.index % 64);
+    if (word >= words.size()) {
+        if (!value) {
+            return false;
+        }
+        words.resize(word + 1, 0);
+    }
+    if (((words[word] & bit) != 0) == value) {
+        return false;
+    }
+    words[word] ^= bit;
+    markChanged(flag.index);
+    return true;
+}
+
+void FlagStore::reset() {
+    words.clear();
+    pendingWords.clear();
+    pending.clear();
+}
+
+std::size_t FlagStore::count() const {
+    std::size_t total = 0;
+    for (std::uint64_t bits : words) {
+        for (; bits != 0; bits &= bits - 1) {
+            ++total;
+        }
+    }
+    return total;
+}
+
+std::vector<StringId> FlagStore::getSetFlags() const {
+    std::vector<StringId> flags;
+    for (std::size_t word = 0; word < words.size(); ++word) {
+        for (std::uint64_t bits = words[word]; bits != 0; bits &= bits - 1) {
+            flags.push_back(StringId(static_cast<std::uint32_t>(word * 64 + trailingZeros(bits))));
+        }
+    }
+    return flags;
+}
+
+void FlagStore::restore(const FlagSnapshot& snapshot) {
+    std::size_t size = std::max(words.size(), snapshot.words.size());
+    words.resize(size, 0);
+    for (std::size_t word = 0; word < size; ++word) {
+        std::uint64_t target = word < snapshot.words.size() ? snapshot.words[word] : 0;
+        for (std::uint64_t bits = words[word] ^ target; bits != 0; bits &= bits - 1) {
+            markChanged(static_cast<std::uint32_t>(word * 64 + trailingZeros(bits)));
+        }
+        words[word] = target;
+    }
+}
+
+std::size_t FlagStore::subscribe(FlagListener listener) {
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        if (!listeners[i]) {
+            listeners[i] = std::move(listener);
+            return i;
+        }
+    }
+    listeners.push_back(std::move(listener));
+    return listeners.size() - 1;
+}
+
+void FlagStore::unsubscribe(std::size_t handle) {
+    if (handle < listeners.size()) {
+        listeners[handle] = nullptr;
+    }
+}
+
+void FlagStore::flush() {
+    if (pending.empty()) {
+        return;
+    }
+    std::vector<StringId> batch;
+    batch.swap(pending);
+    for (StringId flag : batch) {
+        pendingWords[flag.index / 64] &= ~(std::uint64_t(1) << (flag.index % 64));
+    }
+    
+    // Listeners may subscribe or unsubscribe, so each one is called through a copy
+    for (std::size_t i = 0; i < listeners.size(); ++i) {
+        if (listeners[i]) {
+            FlagListener listener = listeners[i];
+            listener(*this, batch);
+        }
+    }
+    
+    // Keep the capacity unless listeners queued more changes
+    if (pending.empty()) {
+        batch.clear();
+        pending.swap(batch);
+    }
+}
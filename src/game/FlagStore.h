@@ -0,0 +1,65 @@
+#pragma once
+#include "../data/StringId.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Copy of every flag's state, e.g. for a save file or a rewind point. Bit i
+// of words[i / 64] is the flag with StringId index i, so it is only
+// meaningful with the id table it was taken with; save files should store
+// the names from FlagStore::getSetFlags() instead.
+struct FlagSnapshot {
+    std::vector<std::uint64_t> words;
+};
+
+class FlagStore;
+
+using FlagListener = std::function<void(const FlagStore& flags, const std::vector<StringId>& changed)>;
+
+// Global story flags ("hungry", "arlong_active", ...) as a bitset indexed by
+// StringId. Testing and setting a flag is one word access.
+//
+// Changes are batched: set() only records which flags changed, and flush(),
+// called once per tick, hands that list to every listener. A listener
+// reads the current values from the store, so a flag set and cleared again
+// within one tick is reported even though it ends where it started.
+// Flags changed by a listener go into the next batch.
+class FlagStore {
+private:
+    std::vector<std::uint64_t> words;
+    std::vector<std::uint64_t> pendingWords; // Flags already in pending
+    std::vector<StringId> pending;
+    std::vector<FlagListener> listeners; // Empty slots are free
+    
+    void markChanged(std::uint32_t index);
+
+public:
+    bool test(StringId flag) const {
+        std::uint32_t word = flag.index / 64;
+        return word < words.size() && (words[word] >> (flag.index % 64) & 1) != 0;
+    }
+    
+    // Returns true if the flag changed
+    bool set(StringId flag, bool value = true);
+    bool clear(StringId flag) { return set(flag, false); }
+    
+    // Clears every flag and drops pending changes without notifying
+    void reset();
+    
+    std::size_t count() const;
+    std::vector<StringId> getSetFlags() const;
+    
+    FlagSnapshot snapshot() const { return FlagSnapshot{ words }; }
+    // Flags that differ from the snapshot are reported as changed
+    void restore(const FlagSnapshot& snapshot);
+    
+    // Returns a handle for unsubscribe
+    std::size_t subscribe(FlagListener listener);
+    void unsubscribe(std::size_t handle);
+    
+    // Notifies the listeners of the changes since the last flush
+    void flush();
+    
+    const std::vector<StringId>& getPendingChanges() const { return pending; }
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include "../data/StringId.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Gameplay events that quests and recruitment requirements wait for. The
+// target is the id of what was defeated, collected, talked to and so on.
+enum class GameEventType : std::uint8_t {
+    Defeat,         // target: enemy
+    Collect,        // target: item
+    TalkTo,         // target: character or npc
+    Visit,          // target: location
+    CompleteQuest,  // target: quest
+    Recruit         // target: character
+};
+
+const std::size_t GAME_EVENT_TYPE_COUNT = 6;
+
+// Maps the requirement types used in the data ("defeat", "complete_quest",
+// ...); returns false for unknown names
+inline bool parseGameEventType(std::string_view name, GameEventType& type) {
+    struct Entry {
+        std::string_view name;
+        GameEventType type;
+    };
+    static const Entry ENTRIES[] = {
+        { "defeat", GameEventType::Defeat },
+        { "collect", GameEventType::Collect },
+        { "talk_to", GameEventType::TalkTo },
+        { "visit", GameEventType::Visit },
+        { "complete_quest", GameEventType::CompleteQuest },
+        { "recruit", GameEventType::Recruit }
+    };
+    for (const Entry& entry : ENTRIES) {
+        if (entry.name == name) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+
+// Small, fast seeded generator (xoshiro128**) for gameplay rolls. The same
+// seed always gives the same sequence, so replays and tests can fix it.
+// Not for anything that needs to be unpredictable.
+class Random {
+private:
+    std::uint32_t state[4];
+    
+    static std::uint32_t rotl(std::uint32_t value, int bits) { return (value << bits) | (value >> (32 - bits)); }
+
+public:
+    explicit Random(std::uint64_t seed = 0) { reseed(seed); }
+    
+    void reseed(std::uint64_t seed) {
+        // splitmix64 spreads any seed, 0 included, over the whole state
+        for (int i = 0; i < 4; i += 2) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t value = seed;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            value ^= value >> 31;
+            state[i] = static_cast<std::uint32_t>(value);
+            state[i + 1] = static_cast<std::uint32_t>(value >> 32);
+        }
+    }
+    
+    std::uint32_t next() {
+        std::uint32_t result = rotl(state[1] * 5, 7) * 9;
+        std::uint32_t shifted = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotl(state[3], 11);
+        return result;
+    }
+    
+    // [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+    
+    // [0, bound), unbiased; bound must not be 0
+    std::uint32_t nextBelow(std::uint32_t bound) {
+        std::uint64_t product = static_cast<std::uint64_t>(next()) * bound;
+        if (static_cast<std::uint32_t>(product) < bound) {
+            std::uint32_t threshold = (0u - bound) % bound;
+            while (static_cast<std::uint32_t>(product) < threshold) {
+                product = static_cast<std::uint64_t>(next()) * bound;
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+};
@@ -0,0 +1,154 @@
+#include "RequirementTracker.h"
+#include "../data/StringInterner.h"
+#include <iostream>
+#include <utility>
+
+RequirementTracker::RequirementTracker() : touchedCount(0) {
+}
+
+std::uint32_t RequirementTracker::addGoal(GoalKind kind, StringId id, const Objective* objectives, std::size_t count, const std::uint8_t* met) {
+    std::uint32_t goal = static_cast<std::uint32_t>(goals.size());
+    TrackedGoal code;
+    code.kind = kind;
+    code.id = id;
+    code.requirementBegin = static_cast<std::uint32_t>(requirements.size());
+    code.requirementCount = 0;
+    code.remaining = 0;
+    goals.push_back(code);
+    
+    for (std::size_t i = 0; i < count; ++i) {
+        // waiting is indexed by target, so an invalid id cannot be tracked
+        if (!objectives[i].target.isValid()) {
+            StringInterner& ids = StringInterner::instance();
+            std::cout << "Warning: requirements: " << ids.name(id) << " has an objective without a valid target; skipped"
+                      << std::endl;
+            continue;
+        }
+        
+        std::uint32_t requirement = static_cast<std::uint32_t>(requirements.size());
+        TrackedRequirement tracked;
+        tracked.objective = objectives[i];
+        tracked.goal = goal;
+        if (met && met[i]) {
+            tracked.progress = tracked.objective.count;
+            requirements.push_back(tracked);
+            continue;
+        }
+        requirements.push_back(tracked);
+        ++goals[goal].remaining;
+        
+        auto& byTarget = waiting[static_cast<std::size_t>(tracked.objective.type)];
+        if (tracked.objective.target.index >= byTarget.size()) {
+            byTarget.resize(tracked.objective.target.index + 1);
+        }
+        byTarget[tracked.objective.target.index].push_back(requirement);
+    }
+    goals[goal].requirementCount = static_cast<std::uint32_t>(requirements.size()) - goals[goal].requirementBegin;
+    
+    if (goals[goal].remaining == 0) {
+        if (onGoalComplete) {
+            onGoalComplete(goals[goal]);
+        }
+        if (kind == GoalKind::Quest) {
+            post(GameEventType::CompleteQuest, id);
+        }
+    }
+    return goal;
+}
+
+void RequirementTracker::addRecruitments(const CharacterFile& characters) {
+    StringInterner& ids = StringInterner::instance();
+    std::vector<Objective> objectives;
+    std::vector<std::uint8_t> met;
+    
+    for (const auto& character : characters.characters) {
+        objectives.clear();
+        met.clear();
+        for (const RecruitmentRequirement& requirement : character.second.recruitmentRequirements) {
+            Objective objective;
+            if (!parseGameEventType(ids.name(requirement.type), objective.type) || !requirement.target.id.isValid()) {
+                std::cout << "Warning: characters: " << ids.name(character.first) << " has an unknown recruitment requirement '"
+                          << ids.name(requirement.type) << "'" << std::endl;
+                continue;
+            }
+            objective.target = requirement.target.id;
+            objectives.push_back(objective);
+            met.push_back(requirement.completed);
+        }
+        if (!objectives.empty()) {
+            addGoal(GoalKind::Recruitment, character.first, objectives.data(), objectives.size(), met.data());
+        }
+    }
+}
+
+std::uint32_t RequirementTracker::addQuest(StringId quest, const std::vector<Objective>& objectives) {
+    return addGoal(GoalKind::Quest, quest, objectives.data(), objectives.size(), nullptr);
+}
+
+void RequirementTracker::clear() {
+    goals.clear();
+    requirements.clear();
+    touchedCount = 0;
+    for (auto& byTarget : waiting) {
+        byTarget.clear();
+    }
+}
+
+void RequirementTracker::meet(std::uint32_t requirement) {
+    const Objective& objective = requirements[requirement].objective;
+    std::vector<std::uint32_t>& list = waiting[static_cast<std::size_t>(objective.type)][objective.target.index];
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        if (list[i] == requirement) {
+            list[i] = list.back();
+            list.pop_back();
+            break;
+        }
+    }
+    
+    if (--goals[requirements[requirement].goal].remaining > 0) {
+        return;
+    }
+    // A copy, since the callback may add goals
+    TrackedGoal goal = goals[requirements[requirement].goal];
+    if (onGoalComplete) {
+        onGoalComplete(goal);
+    }
+    if (goal.kind == GoalKind::Quest) {
+        post(GameEventType::CompleteQuest, goal.id);
+    }
+}
+
+void RequirementTracker::post(GameEventType type, StringId target, int amount) {
+    const auto& byTarget = waiting[static_cast<std::size_t>(type)];
+    if (target.index >= byTarget.size() || byTarget[target.index].empty()) {
+        return;
+    }
+    
+    // Progress first and meet afterwards: meeting a requirement edits the
+    // list, and completion callbacks may add goals
+    std::vector<std::uint32_t> completed;
+    for (std::uint32_t requirement : byTarget[target.index]) {
+        TrackedRequirement& tracked = requirements[requirement];
+        tracked.progress += amount;
+        ++touchedCount;
+        if (tracked.progress >= tracked.objective.count) {
+            completed.push_back(requirement);
+        }
+    }
+    for (std::uint32_t requirement : completed) {
+        meet(requirement);
+    }
+}
+
+void RequirementTracker::setOnGoalComplete(std::function<void(const TrackedGoal&)> callback) {
+    onGoalComplete = std::move(callback);
+}
+
+std::uint32_t RequirementTracker::findGoal(GoalKind kind, StringId id) const {
+    for (std::uint32_t i = 0; i < goals.size(); ++i) {
+        if (goals[i].kind == kind && goals[i].id == id) {
+            return i;
+        }
+    }
+    return NO_GOAL;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "../data/GameRecords.h"
+#include "GameEvent.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+enum class GoalKind : std::uint8_t {
+    Recruitment,  // id: the character to recruit
+    Quest         // id: the quest
+};
+
+// Something a goal waits for, e.g. defeat captain_morgan once
+struct Objective {
+    GameEventType type;
+    StringId target;
+    int count = 1;
+};
+
+struct TrackedRequirement {
+    Objective objective;
+    std::uint32_t goal;
+    int progress = 0;
+};
+
+struct TrackedGoal {
+    GoalKind kind;
+    StringId id;
+    std::uint32_t requirementBegin;
+    std::uint32_t requirementCount;
+    std::uint32_t remaining; // Requirements not met yet
+};
+
+// Tracks recruitment requirements and quest objectives. Open requirements
+// are indexed by (event type, target id), so post() only touches the
+// requirements waiting for that exact event; met requirements leave the
+// index. Completing a quest posts a CompleteQuest event, which is how
+// requirements like "complete_quest recruit_zoro" are met.
+class RequirementTracker {
+private:
+    std::vector<TrackedGoal> goals;
+    std::vector<TrackedRequirement> requirements;
+    // Open requirement indices, by event type and then target index
+    std::vector<std::vector<std::uint32_t>> waiting[GAME_EVENT_TYPE_COUNT];
+    std::function<void(const TrackedGoal&)> onGoalComplete;
+    std::size_t touchedCount;
+    
+    std::uint32_t addGoal(GoalKind kind, StringId id, const Objective* objectives, std::size_t count, const std::uint8_t* met);
+    void meet(std::uint32_t requirement);
+
+public:
+    static constexpr std::uint32_t NO_GOAL = 0xFFFFFFFFu;
+    
+    RequirementTracker();
+    
+    // Adds a goal for every character with recruitment requirements;
+    // requirements marked completed in the data start out met
+    void addRecruitments(const CharacterFile& characters);
+    // Returns the goal index; a quest without objectives completes at once.
+    // Objectives whose target is not a valid id are reported and skipped.
+    std::uint32_t addQuest(StringId quest, const std::vector<Objective>& objectives);
+    void clear();
+    
+    // Advances every open requirement waiting for this event
+    void post(GameEventType type, StringId target, int amount = 1);
+    
+    // Called once per goal, when its last requirement is met
+    void setOnGoalComplete(std::function<void(const TrackedGoal&)> callback);
+    
+    std::uint32_t findGoal(GoalKind kind, StringId id) const;
+    const TrackedGoal& getGoal(std::uint32_t goal) const { return goals[goal]; }
+    const TrackedRequirement& getRequirement(std::uint32_t requirement) const { return requirements[requirement]; }
+    bool isComplete(std::uint32_t goal) const { return goals[goal].remaining == 0; }
+    std::size_t getGoalCount() const { return goals.size(); }
+    
+    // Requirements advanced by post() so far
+    std::size_t getTouchedCount() const { return touchedCount; }
+};
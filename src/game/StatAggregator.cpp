@@ -0,0 +1,240 @@
+#include "StatAggregator.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace {
+    // Stat names as used in statBonuses and setBonuses, in stat order
+    const char* const STAT_NAMES[TOTAL_STAT_COUNT] = {
+        "stamina", "health", "attack", "defense", "speed", "strength", "agility", "devilFruitPower", "haki",
+        "accuracy", "criticalChance", "luck", "range", "dropRate", "reputation", "charisma", "leadership",
+        "willpower", "authority"
+    };
+    
+    // "2_piece" -> 2
+    int pieceCount(std::string_view key) {
+        int count = 0;
+        for (char c : key) {
+            if (c < '0' || c > '9') {
+                break;
+            }
+            count = count * 10 + (c - '0');
+        }
+        return count;
+    }
+}
+
+StatAggregator::StatAggregator(const ItemFile& items) : nextBuffId(0), rebuildCount(0) {
+    StringInterner& ids = StringInterner::instance();
+    for (std::size_t stat = 0; stat < TOTAL_STAT_COUNT; ++stat) {
+        StringId name = ids.intern(STAT_NAMES[stat]);
+        if (name.index >= statByName.size()) {
+            statByName.resize(name.index + 1, -1);
+        }
+        statByName[name.index] = static_cast<std::int8_t>(stat);
+    }
+    
+    for (const auto& category : items.items) {
+        for (const auto& item : category.second) {
+            for (const auto& modifier : item.second.statBonuses) {
+                if (findStat(modifier.first) < 0) {
+                    std::cout << "Warning: items: " << ids.name(item.first) << " has unknown stat '"
+                              << ids.name(modifier.first) << "'" << std::endl;
+                }
+            }
+        }
+    }
+    for (const auto& set : items.itemSets) {
+        for (const auto& setBonus : set.second.setBonuses) {
+            for (const auto& modifier : setBonus.second.stats) {
+                if (findStat(modifier.first) < 0) {
+                    std::cout << "Warning: items: " << ids.name(set.first) << " has unknown stat '"
+                              << ids.name(modifier.first) << "'" << std::endl;
+                }
+            }
+        }
+        for (const Ref<Item>& item : set.second.items) {
+            if (item.id.index >= setByItem.size()) {
+                setByItem.resize(item.id.index + 1, nullptr);
+            }
+            setByItem[item.id.index] = &set.second;
+        }
+    }
+}
+
+int StatAggregator::findStat(StringId name) const {
+    return name.index < statByName.size() ? statByName[name.index] : -1;
+}
+
+const ItemSet* StatAggregator::findSet(const Item& item) const {
+    return item.id.index < setByItem.size() ? setByItem[item.id.index] : nullptr;
+}
+
+std::uint32_t StatAggregator::addMember(const Character& character) {
+    std::uint32_t member = static_cast<std::uint32_t>(members.size());
+    members.emplace_back();
+    for (std::size_t stat = 0; stat < TOTAL_STAT_COUNT; ++stat) {
+        base[stat].push_back(stat < BASE_STAT_COUNT ? static_cast<float>(character.baseStats[stat]) : 0);
+        bonus[stat].push_back(0);
+        stats[stat].push_back(0);
+    }
+    dirty.push_back(1);
+    return member;
+}
+
+void StatAggregator::clear() {
+    members.clear();
+    for (std::size_t stat = 0; stat < TOTAL_STAT_COUNT; ++stat) {
+        base[stat].clear();
+        bonus[stat].clear();
+        stats[stat].clear();
+    }
+    dirty.clear();
+}
+
+bool StatAggregator::equip(std::uint32_t member, const Item& item) {
+    if (!item.equipSlot.isValid()) {
+        return false;
+    }
+    
+    std::vector<const Item*>& equipment = members[member].equipment;
+    if (std::find(equipment.begin(), equipment.end(), &item) != equipment.end()) {
+        return true;
+    }
+    
+    // Everything in the slot goes, except other pieces of the item's own set
+    const ItemSet* set = findSet(item);
+    equipment.erase(std::remove_if(equipment.begin(), equipment.end(), [&](const Item* worn) {
+        return worn->equipSlot == item.equipSlot && (!set || findSet(*worn) != set);
+    }), equipment.end());
+    equipment.push_back(&item);
+    dirty[member] = 1;
+    return true;
+}
+
+bool StatAggregator::unequip(std::uint32_t member, const Item& item) {
+    std::vector<const Item*>& equipment = members[member].equipment;
+    for (std::size_t i = 0; i < equipment.size(); ++i) {
+        if (equipment[i] == &item) {
+            equipment.erase(equipment.begin() + i);
+            dirty[member] = 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint32_t StatAggregator::startBuff(std::uint32_t member, const TemporaryStats& effect) {
+    Buff buff;
+    buff.id = nextBuffId++;
+    buff.attack = static_cast<float>(effect.attack);
+    buff.speed = static_cast<float>(effect.speed);
+    members[member].buffs.push_back(buff);
+    dirty[member] = 1;
+    return buff.id;
+}
+
+bool StatAggregator::endBuff(std::uint32_t member, std::uint32_t buff) {
+    std::vector<Buff>& buffs = members[member].buffs;
+    for (std::size_t i = 0; i < buffs.size(); ++i) {
+        if (buffs[i].id == buff) {
+            buffs.erase(buffs.begin() + i);
+            dirty[member] = 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+void StatAggregator::addModifiers(std::uint32_t member, const RecordMap<int>& modifiers) {
+    for (const auto& modifier : modifiers) {
+        int stat = findStat(modifier.first);
+        if (stat >= 0) {
+            bonus[stat][member] += static_cast<float>(modifier.second);
+        }
+    }
+}
+
+void StatAggregator::rebuild(std::uint32_t member) {
+    for (std::size_t stat = 0; stat < TOTAL_STAT_COUNT; ++stat) {
+        bonus[stat][member] = 0;
+    }
+    
+    const Member& state = members[member];
+    // Pieces worn per item set; a member wears only a handful of items
+    std::vector<std::pair<const ItemSet*, int>> setPieces;
+    for (const Item* item : state.equipment) {
+        addModifiers(member, item->statBonuses);
+        
+        const ItemSet* set = findSet(*item);
+        if (!set) {
+            continue;
+        }
+        bool counted = false;
+        for (auto& pieces : setPieces) {
+            if (pieces.first == set) {
+                ++pieces.second;
+                counted = true;
+            }
+        }
+        if (!counted) {
+            setPieces.emplace_back(set, 1);
+        }
+    }
+    
+    StringInterner& ids = StringInterner::instance();
+    for (const auto& pieces : setPieces) {
+        for (const auto& setBonus : pieces.first->setBonuses) {
+            int required = pieceCount(ids.name(setBonus.first));
+            if (required > 0 && pieces.second >= required) {
+                addModifiers(member, setBonus.second.stats);
+            }
+        }
+    }
+    
+    for (const Buff& buff : state.buffs) {
+        bonus[static_cast<std::size_t>(Stat::Attack)][member] += buff.attack;
+        bonus[static_cast<std::size_t>(Stat::Speed)][member] += buff.speed;
+    }
+    ++rebuildCount;
+}
+
+void StatAggregator::combine(std::uint32_t member) {
+    for (std::size_t stat = 0; stat < TOTAL_STAT_COUNT; ++stat) {
+        stats[stat][member] = base[stat][member] + bonus[stat][member];
+    }
+}
+
+void StatAggregator::update() {
+    bool changed = false;
+    for (std::uint32_t member = 0; member < members.size(); ++member) {
+        if (dirty[member]) {
+            rebuild(member);
+            dirty[member] = 0;
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    
+    // Row by row over the whole party
+    std::size_t count = members.size();
+    for (std::size_t stat = 0; stat < TOTAL_STAT_COUNT; ++stat) {
+        const float* from = base[stat].data();
+        const float* add = bonus[stat].data();
+        float* to = stats[stat].data();
+        for (std::size_t member = 0; member < count; ++member) {
+            to[member] = from[member] + add[member];
+        }
+    }
+}
+
+float StatAggregator::get(std::uint32_t member, std::size_t stat) {
+    if (dirty[member]) {
+        rebuild(member);
+        combine(member);
+        dirty[member] = 0;
+    }
+    return stats[stat][member];
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "../data/GameRecords.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Stats only equipment grants, numbered after the nine base stats
+enum class ExtraStat : std::uint8_t {
+    Accuracy = BASE_STAT_COUNT,
+    CriticalChance,
+    Luck,
+    Range,
+    DropRate,
+    Reputation,
+    Charisma,
+    Leadership,
+    Willpower,
+    Authority
+};
+
+const std::size_t TOTAL_STAT_COUNT = BASE_STAT_COUNT + 10;
+
+// Effective stats of party members: base stats plus equipment, item set
+// and buff modifiers. Results are cached in structure-of-arrays rows
+// (one array per stat, indexed by member), and only equip, unequip and
+// buff start or end mark a member dirty. update() rebuilds the modifiers
+// of the dirty members and then recomputes every row in one pass, so
+// damage code reads stats with a single load.
+//
+// Buff durations are not tracked here; schedule the end with a
+// TimingWheel and call endBuff from its listener.
+class StatAggregator {
+private:
+    struct Buff {
+        std::uint32_t id;
+        float attack;
+        float speed;
+    };
+    
+    struct Member {
+        std::vector<const Item*> equipment; // One per equipSlot, except pieces of one set
+        std::vector<Buff> buffs;
+    };
+    
+    std::vector<Member> members;
+    std::array<std::vector<float>, TOTAL_STAT_COUNT> base;
+    std::array<std::vector<float>, TOTAL_STAT_COUNT> bonus;
+    std::array<std::vector<float>, TOTAL_STAT_COUNT> stats;
+    std::vector<std::uint8_t> dirty;
+    std::vector<std::int8_t> statByName;    // By StringId index, -1 for unknown names
+    std::vector<const ItemSet*> setByItem;  // By item StringId index
+    std::uint32_t nextBuffId;
+    std::size_t rebuildCount;
+    
+    int findStat(StringId name) const;
+    const ItemSet* findSet(const Item& item) const;
+    void addModifiers(std::uint32_t member, const RecordMap<int>& modifiers);
+    void rebuild(std::uint32_t member);
+    void combine(std::uint32_t member);
+
+public:
+    // Unknown stat names in items.json are reported here and ignored later
+    explicit StatAggregator(const ItemFile& items);
+    
+    // Returns the member index
+    std::uint32_t addMember(const Character& character);
+    void clear();
+    
+    // Replaces whatever the member wears in the item's equipSlot, unless
+    // both belong to the same item set (Zoro's swords share the weapon
+    // slot); false for items that cannot be equipped
+    bool equip(std::uint32_t member, const Item& item);
+    bool unequip(std::uint32_t member, const Item& item);
+    // Returns an id for endBuff
+    std::uint32_t startBuff(std::uint32_t member, const TemporaryStats& effect);
+    bool endBuff(std::uint32_t member, std::uint32_t buff);
+    
+    // Recomputes every dirty member
+    void update();
+    
+    // One member's stat, recomputing that member first if it is dirty
+    float get(std::uint32_t member, std::size_t stat);
+    float get(std::uint32_t member, Stat stat) { return get(member, static_cast<std::size_t>(stat)); }
+    // A whole stat row; only current after update()
+    const std::vector<float>& getRow(std::size_t stat) const { return stats[stat]; }
+    
+    bool isDirty(std::uint32_t member) const { return dirty[member] != 0; }
+    std::size_t getMemberCount() const { return members.size(); }
+    // Members whose modifiers were rebuilt so far
+    std::size_t getRebuildCount() const { return rebuildCount; }
+};
@@ -0,0 +1,154 @@
+#include "TimingWheel.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    const std::uint64_t MAX_DELAY = 0xFFFFFFFFull;
+}
+
+TimingWheel::TimingWheel() : freeList(NONE), now(0), activeCount(0) {
+    std::fill(heads, heads + LEVEL_COUNT * SLOT_COUNT, NONE);
+}
+
+void TimingWheel::link(std::uint32_t index) {
+    Node& node = nodes[index];
+    std::uint64_t delay = node.expiry - now;
+    std::uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delay >= (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    
+    std::uint32_t slot = level * SLOT_COUNT + static_cast<std::uint32_t>((node.expiry >> (SLOT_BITS * level)) & (SLOT_COUNT - 1));
+    node.slot = static_cast<std::uint16_t>(slot);
+    node.prev = NONE;
+    node.next = heads[slot];
+    if (node.next != NONE) {
+        nodes[node.next].prev = index;
+    }
+    heads[slot] = index;
+}
+
+void TimingWheel::unlink(std::uint32_t index) {
+    Node& node = nodes[index];
+    if (node.prev != NONE) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.slot] = node.next;
+    }
+    if (node.next != NONE) {
+        nodes[node.next].prev = node.prev;
+    }
+}
+
+void TimingWheel::release(std::uint32_t index) {
+    Node& node = nodes[index];
+    node.slot = NO_SLOT;
+    ++node.generation;
+    node.next = freeList;
+    freeList = index;
+    --activeCount;
+}
+
+TimerHandle TimingWheel::schedule(std::uint64_t delay, std::uint32_t kind, std::uint64_t payload) {
+    std::uint32_t index = freeList;
+    if (index != NONE) {
+        freeList = nodes[index].next;
+    } else {
+        index = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(Node());
+        nodes[index].generation = 0;
+    }
+    
+    Node& node = nodes[index];
+    node.expiry = now + std::min(std::max<std::uint64_t>(delay, 1), MAX_DELAY);
+    node.kind = kind;
+    node.payload = payload;
+    link(index);
+    ++activeCount;
+    return TimerHandle{ index, node.generation };
+}
+
+bool TimingWheel::isActive(TimerHandle handle) const {
+    return handle.index < nodes.size() && nodes[handle.index].generation == handle.generation
+        && nodes[handle.index].slot != NO_SLOT;
+}
+
+bool TimingWheel::cancel(TimerHandle handle) {
+    if (!isActive(handle)) {
+        return false;
+    }
+    unlink(handle.index);
+    release(handle.index);
+    return true;
+}
+
+std::uint64_t TimingWheel::getRemaining(TimerHandle handle) const {
+    return isActive(handle) ? nodes[handle.index].expiry - now : 0;
+}
+
+void TimingWheel::clear() {
+    // Nodes are released rather than dropped so old handles stay stale
+    for (std::uint32_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].slot != NO_SLOT) {
+            release(i);
+        }
+    }
+    std::fill(heads, heads + LEVEL_COUNT * SLOT_COUNT, NONE);
+    now = 0;
+}
+
+void TimingWheel::cascade(std::uint32_t level) {
+    std::uint32_t slot = level * SLOT_COUNT + static_cast<std::uint32_t>((now >> (SLOT_BITS * level)) & (SLOT_COUNT - 1));
+    std::uint32_t index = heads[slot];
+    heads[slot] = NONE;
+    while (index != NONE) {
+        std::uint32_t next = nodes[index].next;
+        link(index);
+        index = next;
+    }
+}
+
+void TimingWheel::step() {
+    ++now;
+    
+    // Higher wheels first, since their timers may land in a lower slot
+    // that turns over on this same tick
+    for (std::uint32_t level = LEVEL_COUNT - 1; level > 0; --level) {
+        if ((now & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+            cascade(level);
+        }
+    }
+    
+    std::uint32_t slot = static_cast<std::uint32_t>(now & (SLOT_COUNT - 1));
+    std::uint32_t index = heads[slot];
+    heads[slot] = NONE;
+    while (index != NONE) {
+        Node& node = nodes[index];
+        std::uint32_t next = node.next;
+        expired.push_back(ExpiredTimer{ TimerHandle{ index, node.generation }, node.kind, node.payload });
+        release(index);
+        index = next;
+    }
+    
+    if (!expired.empty()) {
+        if (onExpired) {
+            onExpired(expired);
+        }
+        expired.clear();
+    }
+}
+
+void TimingWheel::advance(std::uint64_t ticks) {
+    for (std::uint64_t i = 0; i < ticks; ++i) {
+        // Nothing to cascade or expire, so an empty wheel can jump ahead
+        if (activeCount == 0) {
+            now += ticks - i;
+            return;
+        }
+        step();
+    }
+}
+
+void TimingWheel::setOnExpired(std::function<void(const std::vector<ExpiredTimer>&)> callback) {
+    onExpired = std::move(callback);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Identifies a scheduled timer. Handles of expired or cancelled timers stay
+// safe to pass to cancel(), which then does nothing.
+struct TimerHandle {
+    std::uint32_t index = 0xFFFFFFFFu;
+    std::uint32_t generation = 0;
+};
+
+struct ExpiredTimer {
+    TimerHandle handle;
+    std::uint32_t kind;     // Caller-defined, e.g. cooldown or buff
+    std::uint64_t payload;  // Caller-defined, e.g. the entity
+};
+
+// Hierarchical timing wheel over fixed ticks: four wheels of 256 slots,
+// each slot covering 256 times as many ticks as one of the wheel below.
+// A timer sits in one slot's intrusive list until the wheels turn far
+// enough to move it down, so schedule() and cancel() are O(1) and a tick
+// only looks at the timers that are due (plus a cascade every 256 ticks),
+// however many are waiting. Delays are capped at 2^32 - 1 ticks.
+//
+// Everything that expires in one tick is passed to the listener as one
+// batch. Timers scheduled from the listener are relative to that tick.
+class TimingWheel {
+private:
+    struct Node {
+        std::uint64_t expiry;
+        std::uint64_t payload;
+        std::uint32_t kind;
+        std::uint32_t generation;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint16_t slot; // level * SLOT_COUNT + slot, or NO_SLOT when free
+    };
+    
+    static constexpr std::uint32_t LEVEL_COUNT = 4;
+    static constexpr std::uint32_t SLOT_BITS = 8;
+    static constexpr std::uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+    static constexpr std::uint16_t NO_SLOT = 0xFFFF;
+    
+    std::vector<Node> nodes;
+    std::uint32_t freeList;
+    std::uint32_t heads[LEVEL_COUNT * SLOT_COUNT];
+    std::uint64_t now;
+    std::size_t activeCount;
+    std::vector<ExpiredTimer> expired;
+    std::function<void(const std::vector<ExpiredTimer>&)> onExpired;
+    
+    void link(std::uint32_t index);
+    void unlink(std::uint32_t index);
+    void release(std::uint32_t index);
+    void cascade(std::uint32_t level);
+    void step();
+
+public:
+    TimingWheel();
+    
+    // Fires delay ticks from now; a delay of 0 fires on the next tick
+    TimerHandle schedule(std::uint64_t delay, std::uint32_t kind, std::uint64_t payload);
+    // Returns false if the timer already expired or was cancelled
+    bool cancel(TimerHandle handle);
+    bool isActive(TimerHandle handle) const;
+    // Ticks until the timer fires, 0 if it is not active
+    std::uint64_t getRemaining(TimerHandle handle) const;
+    // Drops every timer and restarts at tick 0
+    void clear();
+    
+    // Moves time forward, handing each tick's expired timers to the listener
+    void advance(std::uint64_t ticks = 1);
+    
+    void setOnExpired(std::function<void(const std::vector<ExpiredTimer>&)> callback);
+    
+    std::uint64_t getNow() const { return now; }
+    std::size_t getActiveCount() const { return activeCount; }
+};
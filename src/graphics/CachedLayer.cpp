@@ -0,0 +1,79 @@
+#include "CachedLayer.h"
+#include <cmath>
+
+namespace {
+    // Elements are drawn into the cache with premultiplied output so that
+    // translucent content composites exactly as if drawn directly
+    const sf::BlendMode BLEND_INTO_CACHE(
+        sf::BlendMode::SrcAlpha, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add,
+        sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha, sf::BlendMode::Add);
+    const sf::BlendMode BLEND_PREMULTIPLIED(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+}
+
+CachedLayer::CachedLayer(const sf::FloatRect& layerArea) : area(layerArea), pixelScale(1.0f), dirty(true) {
+}
+
+void CachedLayer::setArea(const sf::FloatRect& layerArea) {
+    area = layerArea;
+    dirty = true;
+}
+
+void CachedLayer::setPixelScale(float scale) {
+    if (scale > 0 && scale != pixelScale) {
+        pixelScale = scale;
+        dirty = true;
+    }
+}
+
+void CachedLayer::add(const sf::Drawable& element) {
+    elements.push_back(&element);
+    dirty = true;
+}
+
+void CachedLayer::clear() {
+    elements.clear();
+    dirty = true;
+}
+
+bool CachedLayer::refresh() {
+    if (!dirty) {
+        return false;
+    }
+    dirty = false;
+    
+    unsigned width = static_cast<unsigned>(std::ceil(area.width * pixelScale));
+    unsigned height = static_cast<unsigned>(std::ceil(area.height * pixelScale));
+    if (width == 0 || height == 0) {
+        return false;
+    }
+    
+    if (texture.getSize() != sf::Vector2u(width, height)) {
+        if (!texture.create(width, height)) {
+            return false;
+        }
+        texture.setSmooth(true);
+    }
+    
+    texture.setView(sf::View(area));
+    texture.clear(sf::Color::Transparent);
+    for (const sf::Drawable* element : elements) {
+        texture.draw(*element, BLEND_INTO_CACHE);
+    }
+    texture.display();
+    
+    // Sprite maps the texture back onto the captured area
+    sprite.setTexture(texture.getTexture(), true);
+    sprite.setPosition(area.left, area.top);
+    sprite.setScale(1.0f / pixelScale, 1.0f / pixelScale);
+    return true;
+}
+
+void CachedLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (elements.empty()) {
+        return;
+    }
+    
+    states.transform *= getTransform();
+    states.blendMode = BLEND_PREMULTIPLIED;
+    target.draw(sprite, states);
+}
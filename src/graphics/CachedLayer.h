@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Renders a set of static drawables once into a texture and draws them back
+// as a single textured quad. The cache is rebuilt by refresh() only after
+// invalidate() or a pixel scale change. Elements are referenced, not copied,
+// and must outlive the layer.
+class CachedLayer : public sf::Drawable, public sf::Transformable {
+private:
+    sf::FloatRect area;
+    float pixelScale;
+    sf::RenderTexture texture;
+    sf::Sprite sprite;
+    std::vector<const sf::Drawable*> elements;
+    bool dirty;
+    
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    explicit CachedLayer(const sf::FloatRect& layerArea = sf::FloatRect());
+    
+    // Region of the scene, in scene coordinates, captured by the layer
+    void setArea(const sf::FloatRect& layerArea);
+    const sf::FloatRect& getArea() const { return area; }
+    
+    // Texture pixels per scene unit, e.g. the window's scale factor
+    void setPixelScale(float scale);
+    
+    void add(const sf::Drawable& element);
+    void clear();
+    void invalidate() { dirty = true; }
+    
+    // Re-renders the cache if needed; returns true when it did
+    bool refresh();
+};
@@ -0,0 +1,123 @@
+#include "ParticleSystem.h"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    const unsigned DOT_TEXTURE_SIZE = 32;
+}
+
+ParticleSystem::ParticleSystem(const ParticleSettings& particleSettings)
+    : settings(particleSettings), vertices(sf::Quads), rng(std::random_device{}()) {
+    updateParams.minX = settings.area.left;
+    updateParams.maxX = settings.area.left + settings.area.width;
+    updateParams.minY = settings.area.top;
+    updateParams.maxY = settings.area.top + settings.area.height;
+    updateParams.baseAlpha = settings.baseAlpha;
+    updateParams.alphaAmplitude = settings.alphaAmplitude;
+    updateParams.pulseSpeed = settings.pulseSpeed;
+    updateParams.phaseScale = settings.phaseScale;
+    particles.rngState = rng() | 1u;
+    
+    createDotTexture();
+}
+
+void ParticleSystem::createDotTexture() {
+    // Filled circle with a one pixel anti-aliased rim, shared by every particle
+    sf::Image image;
+    image.create(DOT_TEXTURE_SIZE, DOT_TEXTURE_SIZE, sf::Color::Transparent);
+    
+    float center = DOT_TEXTURE_SIZE / 2.0f;
+    for (unsigned y = 0; y < DOT_TEXTURE_SIZE; ++y) {
+        for (unsigned x = 0; x < DOT_TEXTURE_SIZE; ++x) {
+            float dx = x + 0.5f - center;
+            float dy = y + 0.5f - center;
+            float coverage = std::min(1.0f, std::max(0.0f, center - std::sqrt(dx * dx + dy * dy)));
+            image.setPixel(x, y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(255 * coverage)));
+        }
+    }
+    
+    dotTexture.loadFromImage(image);
+    dotTexture.setSmooth(true);
+}
+
+void ParticleSystem::spawn(std::size_t count) {
+    std::uniform_real_distribution<float> xDist(updateParams.minX, updateParams.maxX);
+    std::uniform_real_distribution<float> yDist(updateParams.minY, updateParams.maxY);
+    std::uniform_real_distribution<float> sizeDist(settings.minRadius, settings.maxRadius);
+    
+    std::size_t first = particles.size();
+    particles.resize(first + count);
+    for (std::size_t i = first; i < particles.size(); ++i) {
+        particles.x[i] = xDist(rng);
+        particles.y[i] = yDist(rng);
+        particles.vx[i] = settings.velocity.x;
+        particles.vy[i] = settings.velocity.y;
+        particles.radius[i] = sizeDist(rng);
+        particles.phase[i] = particles.x[i] * settings.phaseScale;
+        particles.alpha[i] = settings.baseAlpha;
+        particles.prevX[i] = particles.x[i];
+        particles.prevY[i] = particles.y[i];
+    }
+    
+    vertices.resize(particles.size() * 4);
+    
+    // Texture coordinates never change, so they are written once here
+    float size = static_cast<float>(DOT_TEXTURE_SIZE);
+    for (std::size_t i = first; i < particles.size(); ++i) {
+        sf::Vertex* quad = &vertices[i * 4];
+        quad[0].texCoords = sf::Vector2f(0, 0);
+        quad[1].texCoords = sf::Vector2f(size, 0);
+        quad[2].texCoords = sf::Vector2f(size, size);
+        quad[3].texCoords = sf::Vector2f(0, size);
+    }
+    
+    updateVertices(1);
+}
+
+void ParticleSystem::clear() {
+    particles.clear();
+    vertices.clear();
+}
+
+void ParticleSystem::update(float deltaTime, float time) {
+    particles.storePrevious();
+    kernel.update(particles, updateParams, deltaTime, time);
+}
+
+void ParticleSystem::interpolate(float interpolation) {
+    updateVertices(interpolation);
+}
+
+void ParticleSystem::updateVertices(float interpolation) {
+    sf::Color color = settings.color;
+    
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        float radius = particles.radius[i];
+        float x = particles.prevX[i] + (particles.x[i] - particles.prevX[i]) * interpolation;
+        float y = particles.prevY[i] + (particles.y[i] - particles.prevY[i]) * interpolation;
+        float left = x - radius;
+        float right = x + radius;
+        float upper = y - radius;
+        float lower = y + radius;
+        color.a = static_cast<sf::Uint8>(std::min(255.0f, std::max(0.0f, particles.alpha[i])));
+        
+        sf::Vertex* quad = &vertices[i * 4];
+        quad[0].position = sf::Vector2f(left, upper);
+        quad[1].position = sf::Vector2f(right, upper);
+        quad[2].position = sf::Vector2f(right, lower);
+        quad[3].position = sf::Vector2f(left, lower);
+        quad[0].color = color;
+        quad[1].color = color;
+        quad[2].color = color;
+        quad[3].color = color;
+    }
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (particles.size() == 0) {
+        return;
+    }
+    
+    states.texture = &dotTexture;
+    target.draw(vertices, states);
+}
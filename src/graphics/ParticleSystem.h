@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "../particles/ParticleKernel.h"
+#include <random>
+
+struct ParticleSettings {
+    sf::FloatRect area = sf::FloatRect(0, 0, 1280, 720);
+    sf::Vector2f velocity = sf::Vector2f(0, -20);
+    float minRadius = 1;
+    float maxRadius = 4;
+    sf::Color color = sf::Color(100, 150, 200);
+    
+    // Alpha pulse: baseAlpha + alphaAmplitude * sin(time * pulseSpeed + x * phaseScale)
+    float baseAlpha = 30;
+    float alphaAmplitude = 20;
+    float pulseSpeed = 2;
+    float phaseScale = 0.01f;
+};
+
+// Simulates particles with the SIMD ParticleKernel and draws all of them as
+// textured quads in a single draw call.
+class ParticleSystem : public sf::Drawable {
+private:
+    ParticleSettings settings;
+    ParticleUpdateParams updateParams;
+    ParticleArrays particles;
+    ParticleKernel kernel;
+    sf::VertexArray vertices;
+    sf::Texture dotTexture;
+    std::mt19937 rng;
+    
+    void createDotTexture();
+    void updateVertices(float interpolation);
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    explicit ParticleSystem(const ParticleSettings& particleSettings = ParticleSettings());
+    
+    void spawn(std::size_t count);
+    void clear();
+    void update(float deltaTime, float time);
+    
+    // Rebuilds the quads between the previous (0) and current (1) update
+    void interpolate(float interpolation);
+    
+    std::size_t size() const { return particles.size(); }
+};
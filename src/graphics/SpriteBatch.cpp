@@ -0,0 +1,352 @@
+#include "SpriteBatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Sort key layout: layer | blend mode | texture | submission order
+    const int LAYER_BITS = 16;
+    const int BLEND_BITS = 6;
+    const int TEXTURE_BITS = 18;
+    const int SEQUENCE_BITS = 24;
+    
+    const std::uint32_t DIRECT_STATE = (1u << (BLEND_BITS + TEXTURE_BITS)) - 1;
+    
+    std::uint64_t makeKey(int layer, std::uint32_t state, std::size_t sequence) {
+        std::uint64_t biasedLayer = static_cast<std::uint64_t>(layer + (1 << (LAYER_BITS - 1))) & ((1u << LAYER_BITS) - 1);
+        return (biasedLayer << (BLEND_BITS + TEXTURE_BITS + SEQUENCE_BITS))
+             | (static_cast<std::uint64_t>(state) << SEQUENCE_BITS)
+             | (sequence & ((1u << SEQUENCE_BITS) - 1));
+    }
+    
+    std::uint32_t stateOf(std::uint64_t key) {
+        return static_cast<std::uint32_t>(key >> SEQUENCE_BITS) & DIRECT_STATE;
+    }
+    
+    sf::Vector2f unitNormal(const sf::Vector2f& p1, const sf::Vector2f& p2) {
+        sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
+        float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+        if (length != 0) {
+            normal.x /= length;
+            normal.y /= length;
+        }
+        return normal;
+    }
+}
+
+std::uint32_t SpriteBatch::textureIndex(const sf::Texture* texture) {
+    for (std::size_t i = 0; i < textures.size(); ++i) {
+        if (textures[i] == texture) {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    textures.push_back(texture);
+    return static_cast<std::uint32_t>(textures.size() - 1);
+}
+
+std::uint32_t SpriteBatch::blendIndex(const sf::BlendMode& blendMode) {
+    for (std::size_t i = 0; i < blendModes.size(); ++i) {
+        if (blendModes[i] == blendMode) {
+            return static_cast<std::uint32_t>(i);
+        }
+    }
+    blendModes.push_back(blendMode);
+    return static_cast<std::uint32_t>(blendModes.size() - 1);
+}
+
+void SpriteBatch::pushCommand(int layer, const sf::Texture* texture, const sf::BlendMode& blendMode, std::size_t firstVertex) {
+    std::size_t vertexCount = staging.size() - firstVertex;
+    if (vertexCount == 0) {
+        return;
+    }
+    
+    std::uint32_t state = (blendIndex(blendMode) << TEXTURE_BITS) | textureIndex(texture);
+    Command command;
+    command.key = makeKey(layer, state, commands.size());
+    command.firstVertex = static_cast<std::uint32_t>(firstVertex);
+    command.vertexCount = static_cast<std::uint32_t>(vertexCount);
+    command.direct = -1;
+    commands.push_back(command);
+}
+
+void SpriteBatch::appendQuad(const sf::Transform& transform, const sf::FloatRect& rect, const sf::FloatRect& textureRect,
+                             const sf::Color& color, float shear) {
+    float left = rect.left;
+    float top = rect.top;
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+    
+    float u1 = textureRect.left;
+    float v1 = textureRect.top;
+    float u2 = textureRect.left + textureRect.width;
+    float v2 = textureRect.top + textureRect.height;
+    
+    sf::Vertex topLeft(transform.transformPoint(left - shear * top, top), color, sf::Vector2f(u1, v1));
+    sf::Vertex topRight(transform.transformPoint(right - shear * top, top), color, sf::Vector2f(u2, v1));
+    sf::Vertex bottomLeft(transform.transformPoint(left - shear * bottom, bottom), color, sf::Vector2f(u1, v2));
+    sf::Vertex bottomRight(transform.transformPoint(right - shear * bottom, bottom), color, sf::Vector2f(u2, v2));
+    
+    staging.push_back(topLeft);
+    staging.push_back(topRight);
+    staging.push_back(bottomLeft);
+    staging.push_back(bottomLeft);
+    staging.push_back(topRight);
+    staging.push_back(bottomRight);
+}
+
+void SpriteBatch::appendOutline(const sf::Transform& transform, const std::vector<sf::Vector2f>& points,
+                                float thickness, const sf::Color& color) {
+    // Same extrusion as sf::Shape: offset each point along the averaged edge normals
+    std::size_t count = points.size();
+    sf::Vector2f center;
+    for (const sf::Vector2f& point : points) {
+        center.x += point.x / count;
+        center.y += point.y / count;
+    }
+    
+    std::vector<sf::Vector2f>& outer = outlinePoints;
+    outer.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const sf::Vector2f& p0 = points[(i + count - 1) % count];
+        const sf::Vector2f& p1 = points[i];
+        const sf::Vector2f& p2 = points[(i + 1) % count];
+        
+        sf::Vector2f n1 = unitNormal(p0, p1);
+        sf::Vector2f n2 = unitNormal(p1, p2);
+        if (n1.x * (center.x - p1.x) + n1.y * (center.y - p1.y) > 0) {
+            n1 = sf::Vector2f(-n1.x, -n1.y);
+        }
+        if (n2.x * (center.x - p1.x) + n2.y * (center.y - p1.y) > 0) {
+            n2 = sf::Vector2f(-n2.x, -n2.y);
+        }
+        
+        float factor = 1.0f + (n1.x * n2.x + n1.y * n2.y);
+        sf::Vector2f normal((n1.x + n2.x) / factor, (n1.y + n2.y) / factor);
+        outer[i] = sf::Vector2f(p1.x + normal.x * thickness, p1.y + normal.y * thickness);
+    }
+    
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t next = (i + 1) % count;
+        sf::Vertex a(transform.transformPoint(points[i]), color);
+        sf::Vertex b(transform.transformPoint(outer[i]), color);
+        sf::Vertex c(transform.transformPoint(points[next]), color);
+        sf::Vertex d(transform.transformPoint(outer[next]), color);
+        
+        staging.push_back(a);
+        staging.push_back(b);
+        staging.push_back(c);
+        staging.push_back(c);
+        staging.push_back(b);
+        staging.push_back(d);
+    }
+}
+
+void SpriteBatch::drawQuad(const sf::FloatRect& rect, const sf::Color& color, int layer,
+                           const sf::Texture* texture, const sf::FloatRect& textureRect,
+                           const sf::RenderStates& states) {
+    std::size_t first = staging.size();
+    appendQuad(states.transform, rect, textureRect, color);
+    pushCommand(layer, texture, states.blendMode, first);
+}
+
+void SpriteBatch::draw(const sf::Sprite& sprite, int layer, const sf::RenderStates& states) {
+    if (!sprite.getTexture()) {
+        return;
+    }
+    
+    sf::IntRect source = sprite.getTextureRect();
+    sf::FloatRect rect(0, 0, static_cast<float>(std::abs(source.width)), static_cast<float>(std::abs(source.height)));
+    sf::FloatRect textureRect(static_cast<float>(source.left), static_cast<float>(source.top),
+                              static_cast<float>(source.width), static_cast<float>(source.height));
+    
+    std::size_t first = staging.size();
+    appendQuad(states.transform * sprite.getTransform(), rect, textureRect, sprite.getColor());
+    pushCommand(layer, sprite.getTexture(), states.blendMode, first);
+}
+
+void SpriteBatch::draw(const sf::Shape& shape, int layer, const sf::RenderStates& states) {
+    // Textured shapes keep their own texture mapping
+    if (shape.getTexture()) {
+        drawDirect(shape, layer, states);
+        return;
+    }
+    
+    std::size_t count = shape.getPointCount();
+    if (count < 3) {
+        return;
+    }
+    
+    std::vector<sf::Vector2f>& points = shapePoints;
+    points.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points[i] = shape.getPoint(i);
+    }
+    
+    sf::Transform transform = states.transform * shape.getTransform();
+    std::size_t first = staging.size();
+    
+    // Fill as a fan of triangles (shapes are convex)
+    if (shape.getFillColor().a > 0) {
+        for (std::size_t i = 1; i + 1 < count; ++i) {
+            staging.push_back(sf::Vertex(transform.transformPoint(points[0]), shape.getFillColor()));
+            staging.push_back(sf::Vertex(transform.transformPoint(points[i]), shape.getFillColor()));
+            staging.push_back(sf::Vertex(transform.transformPoint(points[i + 1]), shape.getFillColor()));
+        }
+    }
+    
+    if (shape.getOutlineThickness() != 0 && shape.getOutlineColor().a > 0) {
+        appendOutline(transform, points, shape.getOutlineThickness(), shape.getOutlineColor());
+    }
+    
+    pushCommand(layer, nullptr, states.blendMode, first);
+}
+
+void SpriteBatch::draw(const sf::Text& text, int layer, const sf::RenderStates& states) {
+    const sf::Font* font = text.getFont();
+    const sf::String& string = text.getString();
+    if (!font || string.isEmpty()) {
+        return;
+    }
+    
+    // Glyph layout mirrors sf::Text (underline and strike-through are not supported)
+    unsigned size = text.getCharacterSize();
+    bool bold = (text.getStyle() & sf::Text::Bold) != 0;
+    float shear = (text.getStyle() & sf::Text::Italic) ? 0.209f : 0.0f;
+    float outline = text.getOutlineThickness();
+    
+    float whitespaceWidth = font->getGlyph(L' ', size, bold).advance;
+    float letterSpacing = (whitespaceWidth / 3.0f) * (text.getLetterSpacing() - 1.0f);
+    whitespaceWidth += letterSpacing;
+    float lineSpacing = font->getLineSpacing(size) * text.getLineSpacing();
+    
+    sf::Transform transform = states.transform * text.getTransform();
+    std::size_t first = staging.size();
+    
+    // Outline glyphs go first so the fill is drawn over them
+    for (int pass = outline != 0 ? 0 : 1; pass < 2; ++pass) {
+        bool outlinePass = pass == 0;
+        sf::Color color = outlinePass ? text.getOutlineColor() : text.getFillColor();
+        float x = 0;
+        float y = static_cast<float>(size);
+        sf::Uint32 previous = 0;
+        
+        for (std::size_t i = 0; i < string.getSize(); ++i) {
+            sf::Uint32 current = string[i];
+            if (current == L'\r') {
+                continue;
+            }
+            
+            x += font->getKerning(previous, current, size);
+            previous = current;
+            
+            if (current == L' ' || current == L'\n' || current == L'\t') {
+                if (current == L' ') {
+                    x += whitespaceWidth;
+                } else if (current == L'\t') {
+                    x += whitespaceWidth * 4;
+                } else {
+                    y += lineSpacing;
+                    x = 0;
+                }
+                continue;
+            }
+            
+            const sf::Glyph& glyph = outlinePass ? font->getGlyph(current, size, bold, outline) : font->getGlyph(current, size, bold);
+            float offset = outlinePass ? outline : 0;
+            const float padding = 1.0f;
+            
+            sf::FloatRect rect(x + glyph.bounds.left - padding - offset, y + glyph.bounds.top - padding - offset,
+                               glyph.bounds.width + padding * 2, glyph.bounds.height + padding * 2);
+            sf::FloatRect textureRect(glyph.textureRect.left - padding, glyph.textureRect.top - padding,
+                                      glyph.textureRect.width + padding * 2, glyph.textureRect.height + padding * 2);
+            
+            // Shear is relative to the baseline, so apply it in glyph space
+            sf::Transform glyphTransform = transform;
+            glyphTransform.translate(shear * y, 0);
+            appendQuad(glyphTransform, rect, textureRect, color, shear);
+            
+            if (!outlinePass) {
+                x += glyph.advance + letterSpacing;
+            }
+        }
+    }
+    
+    pushCommand(layer, &font->getTexture(size), states.blendMode, first);
+}
+
+void SpriteBatch::drawDirect(const sf::Drawable& drawable, int layer, const sf::RenderStates& states) {
+    DirectDraw direct;
+    direct.drawable = &drawable;
+    direct.states = states;
+    directDraws.push_back(direct);
+    
+    Command command;
+    command.key = makeKey(layer, DIRECT_STATE, commands.size());
+    command.firstVertex = 0;
+    command.vertexCount = 0;
+    command.direct = static_cast<std::int32_t>(directDraws.size() - 1);
+    commands.push_back(command);
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target) {
+    Stats stats;
+    stats.items = commands.size();
+    
+    std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b) {
+        return a.key < b.key;
+    });
+    
+    ordered.clear();
+    ordered.reserve(staging.size());
+    
+    std::size_t runStart = 0;
+    std::uint32_t runState = 0;
+    std::uint32_t lastDrawnState = DIRECT_STATE + 1;
+    
+    auto submitRun = [&]() {
+        std::size_t count = ordered.size() - runStart;
+        if (count == 0) {
+            return;
+        }
+        
+        sf::RenderStates states(blendModes[runState >> TEXTURE_BITS]);
+        states.texture = textures[runState & ((1u << TEXTURE_BITS) - 1)];
+        target.draw(&ordered[runStart], count, sf::Triangles, states);
+        
+        ++stats.drawCalls;
+        stats.vertices += count;
+        if (runState != lastDrawnState) {
+            ++stats.stateChanges;
+        }
+        lastDrawnState = runState;
+        runStart = ordered.size();
+    };
+    
+    for (const Command& command : commands) {
+        if (command.direct >= 0) {
+            submitRun();
+            const DirectDraw& direct = directDraws[command.direct];
+            target.draw(*direct.drawable, direct.states);
+            ++stats.drawCalls;
+            ++stats.stateChanges;
+            lastDrawnState = DIRECT_STATE;
+            continue;
+        }
+        
+        std::uint32_t state = stateOf(command.key);
+        if (state != runState) {
+            submitRun();
+            runState = state;
+        }
+        
+        ordered.insert(ordered.end(), staging.begin() + command.firstVertex,
+                       staging.begin() + command.firstVertex + command.vertexCount);
+    }
+    submitRun();
+    
+    staging.clear();
+    commands.clear();
+    directDraws.clear();
+    textures.clear();
+    blendModes.clear();
+    lastStats = stats;
+}
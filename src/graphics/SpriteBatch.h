@@ -0,0 +1,71 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Collects quads, sprites, shapes and text for a frame, sorts them by
+// layer, blend mode and texture and submits each run of identical state as
+// one draw call. Lower layers are drawn first. Items within one layer may be
+// reordered to group state, so anything that must overlap in a fixed order
+// belongs on separate layers.
+class SpriteBatch {
+public:
+    struct Stats {
+        std::size_t items = 0;
+        std::size_t drawCalls = 0;
+        std::size_t vertices = 0;
+        std::size_t stateChanges = 0;
+    };
+
+private:
+    struct Command {
+        std::uint64_t key;
+        std::uint32_t firstVertex;
+        std::uint32_t vertexCount;
+        std::int32_t direct; // Index into directDraws, -1 for batched geometry
+    };
+    
+    struct DirectDraw {
+        const sf::Drawable* drawable;
+        sf::RenderStates states;
+    };
+    
+    std::vector<sf::Vertex> staging;
+    std::vector<sf::Vertex> ordered;
+    std::vector<Command> commands;
+    std::vector<DirectDraw> directDraws;
+    std::vector<const sf::Texture*> textures;
+    std::vector<sf::BlendMode> blendModes;
+    // Scratch for shape points and their extruded outline, kept between
+    // calls so drawing a shape does not allocate
+    std::vector<sf::Vector2f> shapePoints;
+    std::vector<sf::Vector2f> outlinePoints;
+    Stats lastStats;
+    
+    std::uint32_t textureIndex(const sf::Texture* texture);
+    std::uint32_t blendIndex(const sf::BlendMode& blendMode);
+    void pushCommand(int layer, const sf::Texture* texture, const sf::BlendMode& blendMode, std::size_t firstVertex);
+    void appendQuad(const sf::Transform& transform, const sf::FloatRect& rect, const sf::FloatRect& textureRect,
+                    const sf::Color& color, float shear = 0);
+    void appendOutline(const sf::Transform& transform, const std::vector<sf::Vector2f>& points,
+                       float thickness, const sf::Color& color);
+
+public:
+    // Untextured when texture is null; textureRect is in pixels
+    void drawQuad(const sf::FloatRect& rect, const sf::Color& color, int layer,
+                  const sf::Texture* texture = nullptr, const sf::FloatRect& textureRect = sf::FloatRect(),
+                  const sf::RenderStates& states = sf::RenderStates::Default);
+    
+    void draw(const sf::Sprite& sprite, int layer, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Shape& shape, int layer, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Text& text, int layer, const sf::RenderStates& states = sf::RenderStates::Default);
+    
+    // Drawn as-is with its own draw call, after the batched items of its layer
+    void drawDirect(const sf::Drawable& drawable, int layer, const sf::RenderStates& states = sf::RenderStates::Default);
+    
+    // Sorts, merges and draws everything submitted since the last flush
+    void flush(sf::RenderTarget& target);
+    
+    const Stats& getStats() const { return lastStats; }
+};
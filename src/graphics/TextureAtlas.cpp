@@ -0,0 +1,62 @@
+#include "TextureAtlas.h"
+#include "../data/StringInterner.h"
+#include <iostream>
+
+bool TextureAtlas::load(const DbValue& index, const std::string& pageDirectory) {
+    pages.clear();
+    regions.clear();
+    
+    if (!index.isObject()) {
+        std::cout << "Warning: missing texture atlas index" << std::endl;
+        return false;
+    }
+    
+    DbValue pageNames = index.find("pages");
+    for (std::size_t i = 0; i < pageNames.size(); ++i) {
+        std::string fileName(pageNames.at(i).asString());
+        std::unique_ptr<sf::Texture> texture(new sf::Texture());
+        if (!texture->loadFromFile(pageDirectory + "/" + fileName)) {
+            std::cout << "Warning: could not load atlas page " << fileName << std::endl;
+            pages.clear();
+            return false;
+        }
+        texture->setSmooth(true);
+        pages.push_back(std::move(texture));
+    }
+    
+    DbValue entries = index.find("regions");
+    regions.reserve(entries.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        // [page, x, y, width, height]
+        DbValue entry = entries.at(i);
+        std::size_t page = static_cast<std::size_t>(entry.at(0).asInt(-1));
+        if (page >= pages.size()) {
+            std::cout << "Warning: atlas region " << entries.keyAt(i) << " references missing page " << page << std::endl;
+            continue;
+        }
+        
+        AtlasRegion region;
+        region.texture = pages[page].get();
+        region.textureRect = sf::FloatRect(static_cast<float>(entry.at(1).asDouble()), static_cast<float>(entry.at(2).asDouble()),
+                                           static_cast<float>(entry.at(3).asDouble()), static_cast<float>(entry.at(4).asDouble()));
+        regions[StringInterner::instance().intern(entries.keyAt(i))] = region;
+    }
+    
+    return true;
+}
+
+const AtlasRegion* TextureAtlas::find(StringId id) const {
+    auto it = regions.find(id);
+    return it != regions.end() ? &it->second : nullptr;
+}
+
+bool TextureAtlas::draw(SpriteBatch& batch, StringId id, const sf::FloatRect& rect, int layer,
+                        const sf::Color& color) const {
+    const AtlasRegion* region = find(id);
+    if (!region) {
+        return false;
+    }
+    
+    batch.drawQuad(rect, color, layer, region->texture, region->textureRect);
+    return true;
+}
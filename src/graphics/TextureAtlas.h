@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "SpriteBatch.h"
+#include "../data/GameDatabase.h"
+#include "../data/StringId.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AtlasRegion {
+    const sf::Texture* texture;
+    sf::FloatRect textureRect; // In pixels
+};
+
+// Runtime side of the opmon_atlas tool: loads the pages listed in an atlas
+// index (compiled into game.db as "atlas.<name>") and resolves textures
+// by id. Icons drawn from the same page merge into a single SpriteBatch
+// draw call.
+class TextureAtlas {
+private:
+    std::vector<std::unique_ptr<sf::Texture>> pages;
+    std::unordered_map<StringId, AtlasRegion> regions; // Keyed by interned item or location id
+
+public:
+    // Page file names are resolved relative to pageDirectory
+    bool load(const DbValue& index, const std::string& pageDirectory);
+    
+    const AtlasRegion* find(StringId id) const;
+    std::size_t getPageCount() const { return pages.size(); }
+    std::size_t getRegionCount() const { return regions.size(); }
+    
+    // Draws the texture stretched over rect; returns false for unknown ids
+    bool draw(SpriteBatch& batch, StringId id, const sf::FloatRect& rect, int layer,
+              const sf::Color& color = sf::Color::White) const;
+};
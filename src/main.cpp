@@ -1,9 +1,46 @@
 #include "scenes/MainMenuScene.h"
+#include "core/Benchmark.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char** argv) {
     try {
-        MainMenuScene mainMenu;
+        // --bench <frames> [--bench-dt <seconds>] runs headless and prints JSON
+        bool bench = false;
+        BenchmarkOptions benchOptions;
+        GameLoopSettings loopSettings;
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+                bench = true;
+                benchOptions.frames = std::max(1, std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--bench-dt") == 0 && i + 1 < argc) {
+                benchOptions.deltaTime = static_cast<float>(std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+                loopSettings.tickRate = static_cast<float>(std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+                loopSettings.pacing.targetRate = static_cast<float>(std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--vsync") == 0) {
+                loopSettings.pacing.vsync = true;
+            } else {
+                std::cout << "Usage: " << argv[0] << " [--tick-rate <hz>] [--fps <rate>] [--vsync] [--bench <frames> [--bench-dt <seconds>]]\n";
+                return -1;
+            }
+        }
+        
+        if (bench) {
+            // Diagnostics printed during the run go to stderr, so stdout
+            // holds nothing but the JSON report
+            benchOptions.loop = loopSettings;
+            std::streambuf* stdoutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+            nlohmann::json report = runSceneBenchmark(benchOptions);
+            std::cout.rdbuf(stdoutBuffer);
+            std::cout << report.dump(2) << std::endl;
+            return 0;
+        }
+        
+        MainMenuScene mainMenu(false, loopSettings);
         mainMenu.run();
     } catch (const std::exception& e) {
         std::cout << "Error: " << e.what() << std::endl;
@@ -11,4 +48,4 @@ int main() {
     }
     
     return 0;
-}
\ No newline at end of file
+}
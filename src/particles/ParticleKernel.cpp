@@ -0,0 +1,265 @@
+#include "ParticleKernel.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPMON_PARTICLES_SSE 1
+#include <emmintrin.h>
+#endif
+
+#if OPMON_PARTICLES_SSE && (defined(__GNUC__) || defined(__clang__))
+#define OPMON_PARTICLES_AVX 1
+#define OPMON_TARGET_AVX __attribute__((target("avx")))
+#include <immintrin.h>
+#elif OPMON_PARTICLES_SSE && defined(__AVX__)
+#define OPMON_PARTICLES_AVX 1
+#define OPMON_TARGET_AVX
+#include <immintrin.h>
+#endif
+
+namespace {
+    const float PI = 3.14159265358979f;
+    const float TWO_PI = 6.28318530717959f;
+    const float INV_TWO_PI = 0.159154943091895f;
+    const float SIN_B = 4.0f / PI;
+    const float SIN_C = -4.0f / (PI * PI);
+    const float SIN_P = 0.225f;
+    
+    float nextRandom(std::uint32_t& state) {
+        // xorshift32, returns [0, 1)
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (state >> 8) * (1.0f / 16777216.0f);
+    }
+    
+    void respawn(ParticleArrays& particles, std::size_t i, const ParticleUpdateParams& params, float pulseTime) {
+        float diameter = particles.radius[i] * 2;
+        particles.y[i] = particles.vy[i] < 0 ? params.maxY + diameter : params.minY - diameter;
+        particles.x[i] = params.minX + (params.maxX - params.minX) * nextRandom(particles.rngState);
+        particles.phase[i] = particles.x[i] * params.phaseScale;
+        particles.alpha[i] = params.baseAlpha + params.alphaAmplitude * fastSin(pulseTime + particles.phase[i]);
+        particles.prevX[i] = particles.x[i];
+        particles.prevY[i] = particles.y[i];
+    }
+    
+    void updateScalar(ParticleArrays& particles, const ParticleUpdateParams& params,
+                      float deltaTime, float pulseTime, std::size_t begin) {
+        std::size_t count = particles.size();
+        for (std::size_t i = begin; i < count; ++i) {
+            particles.x[i] += particles.vx[i] * deltaTime;
+            particles.y[i] += particles.vy[i] * deltaTime;
+            
+            float margin = particles.radius[i] * 2 + 2;
+            if (particles.y[i] < params.minY - margin || particles.y[i] > params.maxY + margin) {
+                respawn(particles, i, params, pulseTime);
+                continue;
+            }
+            
+            particles.alpha[i] = params.baseAlpha + params.alphaAmplitude * fastSin(pulseTime + particles.phase[i]);
+        }
+    }
+
+#if OPMON_PARTICLES_SSE
+    __m128 sinSSE(__m128 x) {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        
+        // Wrap to [-pi, pi]
+        __m128 turns = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_TWO_PI))));
+        x = _mm_sub_ps(x, _mm_mul_ps(turns, _mm_set1_ps(TWO_PI)));
+        
+        __m128 absX = _mm_andnot_ps(signMask, x);
+        __m128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_B), x), _mm_mul_ps(_mm_set1_ps(SIN_C), _mm_mul_ps(x, absX)));
+        __m128 absY = _mm_andnot_ps(signMask, y);
+        return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_P), _mm_sub_ps(_mm_mul_ps(y, absY), y)), y);
+    }
+    
+    std::size_t updateSSE(ParticleArrays& particles, const ParticleUpdateParams& params, float deltaTime, float pulseTime) {
+        std::size_t count = particles.size() & ~static_cast<std::size_t>(3);
+        
+        const __m128 dt = _mm_set1_ps(deltaTime);
+        const __m128 minY = _mm_set1_ps(params.minY);
+        const __m128 maxY = _mm_set1_ps(params.maxY);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 base = _mm_set1_ps(params.baseAlpha);
+        const __m128 amplitude = _mm_set1_ps(params.alphaAmplitude);
+        const __m128 time = _mm_set1_ps(pulseTime);
+        
+        for (std::size_t i = 0; i < count; i += 4) {
+            __m128 x = _mm_add_ps(_mm_loadu_ps(&particles.x[i]), _mm_mul_ps(_mm_loadu_ps(&particles.vx[i]), dt));
+            __m128 y = _mm_add_ps(_mm_loadu_ps(&particles.y[i]), _mm_mul_ps(_mm_loadu_ps(&particles.vy[i]), dt));
+            _mm_storeu_ps(&particles.x[i], x);
+            _mm_storeu_ps(&particles.y[i], y);
+            
+            __m128 alpha = _mm_add_ps(base, _mm_mul_ps(amplitude, sinSSE(_mm_add_ps(time, _mm_loadu_ps(&particles.phase[i])))));
+            _mm_storeu_ps(&particles.alpha[i], alpha);
+            
+            // Respawns are rare, so they are handled per lane after the vector pass
+            __m128 margin = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&particles.radius[i]), two), two);
+            __m128 outside = _mm_or_ps(_mm_cmplt_ps(y, _mm_sub_ps(minY, margin)), _mm_cmpgt_ps(y, _mm_add_ps(maxY, margin)));
+            int mask = _mm_movemask_ps(outside);
+            while (mask) {
+                int lane = 0;
+                while (!(mask & (1 << lane))) {
+                    ++lane;
+                }
+                respawn(particles, i + lane, params, pulseTime);
+                mask &= mask - 1;
+            }
+        }
+        
+        return count;
+    }
+#endif
+
+#if OPMON_PARTICLES_AVX
+    OPMON_TARGET_AVX __m256 sinAVX(__m256 x) {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        
+        // Wrap to [-pi, pi]
+        __m256 turns = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(INV_TWO_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        x = _mm256_sub_ps(x, _mm256_mul_ps(turns, _mm256_set1_ps(TWO_PI)));
+        
+        __m256 absX = _mm256_andnot_ps(signMask, x);
+        __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_B), x), _mm256_mul_ps(_mm256_set1_ps(SIN_C), _mm256_mul_ps(x, absX)));
+        __m256 absY = _mm256_andnot_ps(signMask, y);
+        return _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_P), _mm256_sub_ps(_mm256_mul_ps(y, absY), y)), y);
+    }
+    
+    OPMON_TARGET_AVX std::size_t updateAVX(ParticleArrays& particles, const ParticleUpdateParams& params, float deltaTime, float pulseTime) {
+        std::size_t count = particles.size() & ~static_cast<std::size_t>(7);
+        
+        const __m256 dt = _mm256_set1_ps(deltaTime);
+        const __m256 minY = _mm256_set1_ps(params.minY);
+        const __m256 maxY = _mm256_set1_ps(params.maxY);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        const __m256 base = _mm256_set1_ps(params.baseAlpha);
+        const __m256 amplitude = _mm256_set1_ps(params.alphaAmplitude);
+        const __m256 time = _mm256_set1_ps(pulseTime);
+        
+        for (std::size_t i = 0; i < count; i += 8) {
+            __m256 x = _mm256_add_ps(_mm256_loadu_ps(&particles.x[i]), _mm256_mul_ps(_mm256_loadu_ps(&particles.vx[i]), dt));
+            __m256 y = _mm256_add_ps(_mm256_loadu_ps(&particles.y[i]), _mm256_mul_ps(_mm256_loadu_ps(&particles.vy[i]), dt));
+            _mm256_storeu_ps(&particles.x[i], x);
+            _mm256_storeu_ps(&particles.y[i], y);
+            
+            __m256 alpha = _mm256_add_ps(base, _mm256_mul_ps(amplitude, sinAVX(_mm256_add_ps(time, _mm256_loadu_ps(&particles.phase[i])))));
+            _mm256_storeu_ps(&particles.alpha[i], alpha);
+            
+            __m256 margin = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&particles.radius[i]), two), two);
+            __m256 outside = _mm256_or_ps(_mm256_cmp_ps(y, _mm256_sub_ps(minY, margin), _CMP_LT_OQ),
+                                          _mm256_cmp_ps(y, _mm256_add_ps(maxY, margin), _CMP_GT_OQ));
+            int mask = _mm256_movemask_ps(outside);
+            while (mask) {
+                int lane = 0;
+                while (!(mask & (1 << lane))) {
+                    ++lane;
+                }
+                respawn(particles, i + lane, params, pulseTime);
+                mask &= mask - 1;
+            }
+        }
+        
+        // Avoid AVX-SSE transition penalties in the scalar tail
+        _mm256_zeroupper();
+        return count;
+    }
+#endif
+}
+
+float fastSin(float x) {
+    x -= TWO_PI * std::nearbyint(x * INV_TWO_PI);
+    float y = SIN_B * x + SIN_C * x * std::fabs(x);
+    return SIN_P * (y * std::fabs(y) - y) + y;
+}
+
+void ParticleArrays::resize(std::size_t count) {
+    x.resize(count);
+    y.resize(count);
+    vx.resize(count);
+    vy.resize(count);
+    radius.resize(count);
+    phase.resize(count);
+    alpha.resize(count);
+    prevX.resize(count);
+    prevY.resize(count);
+}
+
+void ParticleArrays::clear() {
+    resize(0);
+}
+
+void ParticleArrays::storePrevious() {
+    prevX = x;
+    prevY = y;
+}
+
+ParticleKernel::ParticleKernel(Backend preferred) : backend(preferred) {
+    // Fall back step by step until we reach something the CPU can run
+    while (!isSupported(backend)) {
+        backend = backend == Backend::AVX ? Backend::SSE : Backend::Scalar;
+    }
+}
+
+void ParticleKernel::update(ParticleArrays& particles, const ParticleUpdateParams& params, float deltaTime, float time) const {
+    float pulseTime = time * params.pulseSpeed;
+    std::size_t processed = 0;
+    
+    switch (backend) {
+#if OPMON_PARTICLES_AVX
+        case Backend::AVX:
+            processed = updateAVX(particles, params, deltaTime, pulseTime);
+            break;
+#endif
+#if OPMON_PARTICLES_SSE
+        case Backend::SSE:
+            processed = updateSSE(particles, params, deltaTime, pulseTime);
+            break;
+#endif
+        default:
+            break;
+    }
+    
+    updateScalar(particles, params, deltaTime, pulseTime, processed);
+}
+
+ParticleKernel::Backend ParticleKernel::bestBackend() {
+    if (isSupported(Backend::AVX)) {
+        return Backend::AVX;
+    }
+    if (isSupported(Backend::SSE)) {
+        return Backend::SSE;
+    }
+    return Backend::Scalar;
+}
+
+bool ParticleKernel::isSupported(Backend candidate) {
+    switch (candidate) {
+        case Backend::Scalar:
+            return true;
+        case Backend::SSE:
+#if OPMON_PARTICLES_SSE
+            return true;
+#else
+            return false;
+#endif
+        case Backend::AVX:
+#if OPMON_PARTICLES_AVX && (defined(__GNUC__) || defined(__clang__))
+            return __builtin_cpu_supports("avx");
+#elif OPMON_PARTICLES_AVX
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* ParticleKernel::backendName(Backend candidate) {
+    switch (candidate) {
+        case Backend::Scalar: return "scalar";
+        case Backend::SSE: return "sse";
+        case Backend::AVX: return "avx";
+    }
+    return "unknown";
+}
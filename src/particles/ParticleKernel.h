@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Structure-of-arrays particle storage. Every attribute lives in its own
+// contiguous array so the update kernel can process several particles per
+// instruction. This header has no SFML dependency.
+struct ParticleArrays {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> radius;
+    std::vector<float> phase;
+    std::vector<float> alpha;
+    
+    // Positions before the last update, for render interpolation. The kernel
+    // only writes these when respawning so a wrapped particle doesn't streak.
+    std::vector<float> prevX;
+    std::vector<float> prevY;
+    
+    std::uint32_t rngState = 0x9E3779B9u;
+    
+    std::size_t size() const { return x.size(); }
+    void resize(std::size_t count);
+    void clear();
+    void storePrevious();
+};
+
+struct ParticleUpdateParams {
+    // Particles are respawned once they leave [minY, maxY] by more than their diameter
+    float minX = 0;
+    float maxX = 1280;
+    float minY = 0;
+    float maxY = 720;
+    
+    // alpha = baseAlpha + alphaAmplitude * sin(time * pulseSpeed + phase)
+    float baseAlpha = 30;
+    float alphaAmplitude = 20;
+    float pulseSpeed = 2;
+    
+    // Phase assigned to respawned particles: x * phaseScale
+    float phaseScale = 0.01f;
+};
+
+class ParticleKernel {
+public:
+    enum class Backend {
+        Scalar,
+        SSE,
+        AVX
+    };
+    
+private:
+    Backend backend;
+
+public:
+    explicit ParticleKernel(Backend preferred = bestBackend());
+    
+    // Integrates positions, respawns particles that left the area and
+    // writes the pulsing alpha (0-255) for every particle.
+    void update(ParticleArrays& particles, const ParticleUpdateParams& params, float deltaTime, float time) const;
+    
+    Backend getBackend() const { return backend; }
+    
+    static Backend bestBackend();
+    static bool isSupported(Backend candidate);
+    static const char* backendName(Backend candidate);
+};
+
+// Parabolic sine approximation shared by every backend (max error ~0.001)
+float fastSin(float x);
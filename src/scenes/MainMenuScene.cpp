@@ -2,16 +2,44 @@
 #include <iostream>
 #include <cmath>
 #include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
 
 #include "MainMenuScene.h"
 #include <iostream>
 #include <cmath>
 #include <random>
 
-MainMenuScene::MainMenuScene() : window(sf::VideoMode(1280, 720), "OPMON Red"), animationTime(0), titlePulse(0) {
-    window.setFramerateLimit(60);
+namespace {
+    // Draw order of the menu; buttons use three consecutive layers
+    enum RenderLayer {
+        LAYER_BACKGROUND,
+        LAYER_PARTICLES,
+        LAYER_PANEL,
+        LAYER_TITLE,
+        LAYER_BUTTONS
+    };
+}
+
+MainMenuScene::MainMenuScene(bool headlessMode, const GameLoopSettings& loopSettings)
+    : target(nullptr), headless(headlessMode), closed(false), focused(true), redrawPending(true), syntheticMouse(-1, -1),
+      animationTime(0), titlePulse(0), previousTitlePulse(0), loop(loopSettings) {
+    if (headless) {
+        // Offscreen rendering still needs a GL context, e.g. Mesa llvmpipe
+        if (!offscreen.create(1280, 720)) {
+            throw std::runtime_error("Could not create offscreen render target");
+        }
+        target = &offscreen;
+    } else {
+        window.create(sf::VideoMode(1280, 720), "OPMON Red");
+        window.setVerticalSyncEnabled(loopSettings.pacing.vsync);
+        target = &window;
+    }
+    
     setupBackground();
     setupUI();
+    setupLayers();
     createParticles();
 }
 
@@ -29,20 +57,8 @@ void MainMenuScene::setupBackground() {
 }
 
 void MainMenuScene::createParticles() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> xDist(0, 1280);
-    std::uniform_real_distribution<float> yDist(0, 720);
-    std::uniform_real_distribution<float> sizeDist(1, 4);
-    
     backgroundParticles.clear();
-    for (int i = 0; i < 50; ++i) {
-        sf::CircleShape particle;
-        particle.setRadius(sizeDist(gen));
-        particle.setPosition(xDist(gen), yDist(gen));
-        particle.setFillColor(sf::Color(100, 150, 200, 50));
-        backgroundParticles.push_back(particle);
-    }
+    backgroundParticles.spawn(50);
 }
 
 void MainMenuScene::setupUI() {
@@ -82,6 +98,10 @@ void MainMenuScene::setupUI() {
     versionText.setFillColor(sf::Color(150, 150, 150, 200));
     versionText.setPosition(20, 680);
     
+#ifdef OPMON_ENABLE_PROFILER
+    profilerOverlay.setFont(font);
+#endif
+    
     // Create enhanced buttons
     buttons.clear();
     
@@ -132,30 +152,125 @@ void MainMenuScene::setupUI() {
     buttons.push_back(std::move(quitBtn));
 }
 
-void MainMenuScene::run() {
-    sf::Clock deltaClock;
+void MainMenuScene::setupLayers() {
+    panelLayer.setArea(sf::FloatRect(0, 0, 1280, 720));
+    panelLayer.add(titleBackground);
+    panelLayer.add(subtitleText);
+    panelLayer.add(versionText);
     
-    while (window.isOpen()) {
-        float deltaTime = deltaClock.restart().asSeconds();
-        animationTime += deltaTime;
-        
-        handleEvents();
-        update();
-        updateAnimations(deltaTime);
-        render();
+    // Capture the title at rest, padded for its outline
+    sf::FloatRect titleBounds = titleText.getGlobalBounds();
+    float padding = titleText.getOutlineThickness() + 4;
+    titleLayer.setArea(sf::FloatRect(
+        std::floor(titleBounds.left - padding),
+        std::floor(titleBounds.top - padding),
+        std::ceil(titleBounds.width + padding * 2),
+        std::ceil(titleBounds.height + padding * 2)
+    ));
+    titleLayer.add(titleText);
+    
+    // Pulse around the same point the text used to scale about
+    sf::Vector2f pulseCenter(640, 140 + titleText.getLocalBounds().height / 2);
+    titleLayer.setOrigin(pulseCenter);
+    titleLayer.setPosition(pulseCenter);
+    
+    updateLayerScale(headless ? offscreen.getSize() : window.getSize());
+}
+
+void MainMenuScene::updateLayerScale(sf::Vector2u windowSize) {
+    float scale = std::min(windowSize.x / 1280.0f, windowSize.y / 720.0f);
+    panelLayer.setPixelScale(scale);
+    
+    // The title is shown up to 5% larger, so cache it at that resolution
+    titleLayer.setPixelScale(scale * 1.05f);
+}
+
+sf::Vector2i MainMenuScene::getMousePosition() const {
+    return headless ? syntheticMouse : sf::Mouse::getPosition(window);
+}
+
+void MainMenuScene::close() {
+    closed = true;
+    if (!headless) {
+        window.close();
     }
 }
 
+bool MainMenuScene::isOpen() const {
+    return headless ? !closed : window.isOpen();
+}
+
+void MainMenuScene::run() {
+#ifdef OPMON_ENABLE_PROFILER
+    // OPMON_TRACE=<file> starts a trace capture from the first frame
+    if (const char* tracePath = std::getenv("OPMON_TRACE")) {
+        TraceRecorder::instance().start(tracePath);
+    }
+#endif
+    
+    loop.run(*this);
+    
+    FramePacer::Stats pacing = loop.getPacer().getStats();
+    std::cout << "Frame pacing: " << pacing.frames << " frames, error mean " << pacing.meanErrorMs
+              << " ms, p99 " << pacing.p99ErrorMs << " ms, max " << pacing.maxErrorMs
+              << " ms, " << pacing.missedDeadlines << " missed deadlines\n";
+    
+#ifdef OPMON_ENABLE_PROFILER
+    TraceRecorder::instance().stop();
+#endif
+}
+
+void MainMenuScene::step(float frameTime) {
+    loop.frame(*this, frameTime);
+}
+
+bool MainMenuScene::isPaused() const {
+    return !focused;
+}
+
+bool MainMenuScene::needsRedraw() const {
+    // Particles and the title animate every tick, so only a paused menu is static
+    return focused || redrawPending;
+}
+
+void MainMenuScene::fixedUpdate(float deltaTime) {
+    animationTime += deltaTime;
+    
+    update(deltaTime);
+    updateAnimations(deltaTime);
+}
+
 void MainMenuScene::handleEvents() {
+    OPMON_PROFILE_SCOPE(ProfilePhase::Events);
+    
+    if (headless) {
+        return;
+    }
+    
     sf::Event event;
     while (window.pollEvent(event)) {
         if (event.type == sf::Event::Closed) {
-            window.close();
+            close();
+        }
+        
+        // Pause animation while unfocused; the loop drops to its idle rate
+        if (event.type == sf::Event::LostFocus) {
+            focused = false;
+        }
+        
+        if (event.type == sf::Event::GainedFocus) {
+            focused = true;
+            redrawPending = true;
+        }
+        
+        if (event.type == sf::Event::Resized) {
+            updateLayerScale(sf::Vector2u(event.size.width, event.size.height));
+            redrawPending = true;
         }
         
         if (event.type == sf::Event::MouseButtonPressed) {
             if (event.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+                sf::Vector2i mousePos = getMousePosition();
                 for (auto& button : buttons) {
                     button->handleClick(mousePos);
                 }
@@ -164,81 +279,107 @@ void MainMenuScene::handleEvents() {
         
         if (event.type == sf::Event::KeyPressed) {
             if (event.key.code == sf::Keyboard::Escape) {
-                window.close();
+                close();
+            }
+            
+#ifdef OPMON_ENABLE_PROFILER
+            if (event.key.code == sf::Keyboard::F3) {
+                profilerOverlay.toggle();
+            }
+            
+            if (event.key.code == sf::Keyboard::F4) {
+                TraceRecorder::instance().requestToggle();
             }
+#endif
         }
     }
 }
 
-void MainMenuScene::update() {
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+void MainMenuScene::update(float deltaTime) {
+    OPMON_PROFILE_SCOPE(ProfilePhase::Update);
+    
+    sf::Vector2i mousePos = getMousePosition();
     for (auto& button : buttons) {
-        button->update(mousePos, 1.0f/60.0f); // Assuming 60 FPS
+        button->update(mousePos, deltaTime);
     }
 }
 
 void MainMenuScene::updateAnimations(float deltaTime) {
+    OPMON_PROFILE_SCOPE(ProfilePhase::Animation);
+    
     // Title pulsing effect
+    previousTitlePulse = titlePulse;
     titlePulse += deltaTime * 2.0f;
-    float pulseFactor = 1.0f + 0.05f * std::sin(titlePulse);
-    
-    sf::FloatRect titleBounds = titleText.getLocalBounds();
-    titleText.setScale(pulseFactor, pulseFactor);
-    titleText.setPosition(
-        (1280 - titleBounds.width * pulseFactor) / 2,
-        140 - (titleBounds.height * (pulseFactor - 1.0f)) / 2
-    );
     
     // Update particles
     updateParticles(deltaTime);
 }
 
+void MainMenuScene::applyTitlePulse(float pulse) {
+    float pulseFactor = 1.0f + 0.05f * std::sin(pulse);
+    titleLayer.setScale(pulseFactor, pulseFactor);
+}
+
 void MainMenuScene::updateParticles(float deltaTime) {
-    for (auto& particle : backgroundParticles) {
-        sf::Vector2f pos = particle.getPosition();
-        pos.y -= 20 * deltaTime; // Slow upward movement
-        
-        // Reset particle if it goes off screen
-        if (pos.y < -10) {
-            pos.y = 730;
-            pos.x = rand() % 1280;
-        }
-        
-        particle.setPosition(pos);
-        
-        // Subtle alpha animation
-        sf::Uint8 alpha = 30 + 20 * std::sin(animationTime * 2 + pos.x * 0.01f);
-        particle.setFillColor(sf::Color(100, 150, 200, alpha));
-    }
+    // Slow upward drift with a subtle alpha pulse
+    backgroundParticles.update(deltaTime, animationTime);
 }
 
-void MainMenuScene::render() {
-    window.clear();
+void MainMenuScene::render(float alpha) {
+    OPMON_PROFILE_SCOPE(ProfilePhase::Render);
+    
+    redrawPending = false;
+    
+    // Place animated elements between the last two simulation ticks
+    applyTitlePulse(previousTitlePulse + (titlePulse - previousTitlePulse) * alpha);
+    backgroundParticles.interpolate(alpha);
+    for (auto& button : buttons) {
+        button->interpolate(alpha);
+    }
+    
+#ifdef OPMON_ENABLE_PROFILER
+    profilerOverlay.update(Profiler::instance(), &loop.getPacer(), &batch.getStats());
+#endif
+    
+    // Rebuild cached layers only if their content or scale changed
+    panelLayer.refresh();
+    titleLayer.refresh();
+    
+    target->clear();
     
     // Draw background
-    window.draw(background);
+    batch.draw(background, LAYER_BACKGROUND);
     
     // Draw particles
-    for (const auto& particle : backgroundParticles) {
-        window.draw(particle);
-    }
+    batch.drawDirect(backgroundParticles, LAYER_PARTICLES);
     
-    // Draw title background
-    window.draw(titleBackground);
+    // Draw title background, subtitle and version
+    batch.drawDirect(panelLayer, LAYER_PANEL);
     
-    // Draw title and subtitle
-    window.draw(titleText);
-    window.draw(subtitleText);
+    // Draw title
+    batch.drawDirect(titleLayer, LAYER_TITLE);
     
     // Draw buttons
     for (auto& button : buttons) {
-        button->draw(window);
+        button->draw(batch, LAYER_BUTTONS);
     }
     
-    // Draw version
-    window.draw(versionText);
+    batch.flush(*target);
     
-    window.display();
+#ifdef OPMON_ENABLE_PROFILER
+    // Draw profiler overlay on top of everything
+    target->draw(profilerOverlay);
+#endif
+}
+
+void MainMenuScene::present() {
+    // Buffer swap; blocks until vblank when vsync is enabled
+    OPMON_PROFILE_SCOPE(ProfilePhase::Present);
+    if (headless) {
+        offscreen.display();
+    } else {
+        window.display();
+    }
 }
 
 void MainMenuScene::onNewGame() {
@@ -258,5 +399,5 @@ void MainMenuScene::onSettings() {
 
 void MainMenuScene::onQuit() {
     std::cout << "Quit clicked! Thanks for sailing with the Straw Hats!\n";
-    window.close();
+    close();
 }
\ No newline at end of file
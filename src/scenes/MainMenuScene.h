@@ -1,12 +1,28 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "Scene.h"
+#include "../core/GameLoop.h"
 #include "../ui/Button.h"
+#include "../graphics/ParticleSystem.h"
+#include "../graphics/CachedLayer.h"
+#include "../graphics/SpriteBatch.h"
+#include "../debug/ProfilerOverlay.h"
+#include "../debug/Instrumentation.h"
 #include <vector>
 #include <memory>
 
-class MainMenuScene {
+class MainMenuScene : public Scene {
 private:
+    // Rendering goes to the window, or to an offscreen texture when headless
     sf::RenderWindow window;
+    sf::RenderTexture offscreen;
+    sf::RenderTarget* target;
+    bool headless;
+    bool closed;
+    bool focused;
+    bool redrawPending;
+    sf::Vector2i syntheticMouse;
+    
     sf::Font font;
     sf::Font subtitleFont;
     sf::Text titleText;
@@ -16,7 +32,15 @@ private:
     // Background elements
     sf::RectangleShape background;
     sf::RectangleShape titleBackground;
-    std::vector<sf::CircleShape> backgroundParticles;
+    ParticleSystem backgroundParticles;
+    
+    // Title panel, subtitle and version never change, so they are drawn from
+    // one cached texture; the pulsing title is scaled from its own cache
+    CachedLayer panelLayer;
+    CachedLayer titleLayer;
+    
+    // Everything except the debug overlay is drawn through one sorted batch
+    SpriteBatch batch;
     
     // UI elements
     std::vector<std::unique_ptr<Button>> buttons;
@@ -24,15 +48,35 @@ private:
     // Animation
     float animationTime;
     float titlePulse;
+    float previousTitlePulse;
+    
+    // Fixed-rate simulation, rendered once per frame with interpolation
+    GameLoop loop;
+    
+#ifdef OPMON_ENABLE_PROFILER
+    // Debug
+    ProfilerOverlay profilerOverlay;
+#endif
     
     void setupUI();
     void setupBackground();
     void createParticles();
-    void handleEvents();
-    void update();
-    void render();
+    void setupLayers();
+    void updateLayerScale(sf::Vector2u windowSize);
+    sf::Vector2i getMousePosition() const;
+    void close();
+    void update(float deltaTime);
     void updateAnimations(float deltaTime);
     void updateParticles(float deltaTime);
+    void applyTitlePulse(float pulse);
+    
+    // Scene
+    void handleEvents() override;
+    void fixedUpdate(float deltaTime) override;
+    bool isPaused() const override;
+    bool needsRedraw() const override;
+    void render(float alpha) override;
+    void present() override;
     
     // Button callbacks
     void onNewGame();
@@ -41,6 +85,14 @@ private:
     void onQuit();
 
 public:
-    MainMenuScene();
+    explicit MainMenuScene(bool headlessMode = false, const GameLoopSettings& loopSettings = GameLoopSettings());
+    
     void run();
+    
+    // Advances by frameTime seconds and renders exactly one frame
+    void step(float frameTime);
+    bool isOpen() const override;
+    
+    // Pointer used in place of the real mouse when headless
+    void setSyntheticMouse(sf::Vector2i position) { syntheticMouse = position; }
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+// Interface driven by GameLoop. Simulation advances in fixed ticks while
+// render() receives how far the current frame is between the last two.
+class Scene {
+public:
+    virtual ~Scene() = default;
+    
+    virtual bool isOpen() const = 0;
+    virtual void handleEvents() = 0;
+    virtual void fixedUpdate(float deltaTime) = 0;
+    
+    // While paused no ticks run and the loop paces at its idle rate
+    virtual bool isPaused() const { return false; }
+    
+    // Returning false skips render() and present() for the frame
+    virtual bool needsRedraw() const { return true; }
+    
+    // alpha in [0, 1): 0 is the previous tick's state, 1 the latest tick's
+    virtual void render(float alpha) = 0;
+    virtual void present() = 0;
+};
@@ -1,8 +1,9 @@
 #include "Button.h"
+#include "../debug/Instrumentation.h"
 #include <cmath>
 
 Button::Button(const std::string& buttonText, sf::Font& buttonFont, float x, float y, float width, float height) 
-    : font(&buttonFont), isHovered(false), isPressed(false), hoverScale(1.0f), targetScale(1.0f), animationSpeed(8.0f) {
+    : font(&buttonFont), isHovered(false), isPressed(false), hoverScale(1.0f), previousScale(1.0f), targetScale(1.0f), animationSpeed(8.0f) {
     
     originalPosition = sf::Vector2f(x, y);
     originalSize = sf::Vector2f(width, height);
@@ -52,6 +53,8 @@ void Button::setOnClick(std::function<void()> callback) {
 }
 
 void Button::update(sf::Vector2i mousePos, float deltaTime) {
+    OPMON_PROFILE_SCOPE(ProfilePhase::ButtonUpdate);
+    
     bool wasHovered = isHovered;
     isHovered = contains(mousePos);
     
@@ -59,13 +62,31 @@ void Button::update(sf::Vector2i mousePos, float deltaTime) {
     targetScale = isHovered ? 1.05f : 1.0f;
     
     // Smooth scale animation
+    previousScale = hoverScale;
     float scaleDiff = targetScale - hoverScale;
     hoverScale += scaleDiff * animationSpeed * deltaTime;
     
-    // Apply scale
+    // Update visual state with smooth color transitions
+    if (isPressed) {
+        shape.setFillColor(pressColor);
+        shape.setOutlineColor(sf::Color(150, 200, 255, 255));
+    } else if (isHovered) {
+        shape.setFillColor(hoverColor);
+        shape.setOutlineColor(sf::Color(120, 170, 220, 220));
+    } else {
+        shape.setFillColor(normalColor);
+        shape.setOutlineColor(sf::Color(100, 150, 200, 180));
+    }
+}
+
+void Button::interpolate(float alpha) {
+    applyScale(previousScale + (hoverScale - previousScale) * alpha);
+}
+
+void Button::applyScale(float scale) {
     sf::Vector2f scaledSize = originalSize;
-    scaledSize.x *= hoverScale;
-    scaledSize.y *= hoverScale;
+    scaledSize.x *= scale;
+    scaledSize.y *= scale;
     
     sf::Vector2f scaledPos = originalPosition;
     scaledPos.x -= (scaledSize.x - originalSize.x) / 2;
@@ -84,18 +105,6 @@ void Button::update(sf::Vector2i mousePos, float deltaTime) {
         scaledPos.x + (scaledSize.x - textBounds.width) / 2 - textBounds.left,
         scaledPos.y + (scaledSize.y - textBounds.height) / 2 - textBounds.top
     );
-    
-    // Update visual state with smooth color transitions
-    if (isPressed) {
-        shape.setFillColor(pressColor);
-        shape.setOutlineColor(sf::Color(150, 200, 255, 255));
-    } else if (isHovered) {
-        shape.setFillColor(hoverColor);
-        shape.setOutlineColor(sf::Color(120, 170, 220, 220));
-    } else {
-        shape.setFillColor(normalColor);
-        shape.setOutlineColor(sf::Color(100, 150, 200, 180));
-    }
 }
 
 void Button::handleClick(sf::Vector2i mousePos) {
@@ -107,12 +116,14 @@ void Button::handleClick(sf::Vector2i mousePos) {
     }
 }
 
-void Button::draw(sf::RenderWindow& window) {
+void Button::draw(SpriteBatch& batch, int layer) {
+    OPMON_PROFILE_SCOPE(ProfilePhase::ButtonDraw);
+    
     // Draw shadow first
-    window.draw(shadowShape);
+    batch.draw(shadowShape, layer);
     // Draw button
-    window.draw(shape);
-    window.draw(text);
+    batch.draw(shape, layer + 1);
+    batch.draw(text, layer + 2);
 }
 
 bool Button::contains(sf::Vector2i point) {
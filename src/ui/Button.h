@@ -1,5 +1,6 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "../graphics/SpriteBatch.h"
 #include <string>
 #include <functional>
 
@@ -21,12 +22,15 @@ private:
     
     // Animation
     float hoverScale;
+    float previousScale;
     float targetScale;
     float animationSpeed;
     
     // Position
     sf::Vector2f originalPosition;
     sf::Vector2f originalSize;
+    
+    void applyScale(float scale);
 
 public:
     Button(const std::string& buttonText, sf::Font& buttonFont, float x, float y, float width, float height);
@@ -35,8 +39,14 @@ public:
     void setOnClick(std::function<void()> callback);
     
     void update(sf::Vector2i mousePos, float deltaTime);
+    
+    // Lays out the button between its previous and current scale for rendering
+    void interpolate(float alpha);
     void handleClick(sf::Vector2i mousePos);
-    void draw(sf::RenderWindow& window);
+    
+    // Submits shadow, shape and text on layer, layer + 1 and layer + 2 so all
+    // buttons sharing those layers merge into two draw calls
+    void draw(SpriteBatch& batch, int layer);
     
     bool contains(sf::Vector2i point);
 };
\ No newline at end of file
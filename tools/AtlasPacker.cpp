@@ -0,0 +1,334 @@
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb/stb_image.h>
+#include <stb/stb_image_write.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Usage: opmon_atlas --data <file.json> --field <name> --name <atlas> --out <dir>
+//                    [--root <dir>] [--page-size <px>] [--padding <px>]
+// Packs every texture referenced by <field> in the data file into atlas
+// pages (<atlas>_<n>.png) and writes <atlas>.atlas.json mapping each id to
+// [page, x, y, width, height]. Missing or unreadable files are reported and
+// mapped to a shared placeholder so the runtime lookup never fails.
+namespace {
+    const char* MISSING_ID = "__missing__";
+    const int PLACEHOLDER_SIZE = 16;
+    
+    struct Image {
+        std::string id;
+        std::string path;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels; // RGBA
+        int page = -1;
+        int x = 0;
+        int y = 0;
+    };
+    
+    // Bottom-left skyline: the top edge of the packed area as a list of
+    // horizontal segments; each rectangle rests on the lowest span it fits
+    class SkylinePage {
+    private:
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+        
+        int size;
+        std::vector<Segment> skyline;
+        
+        // Height the rectangle would rest at if placed on segment index, or -1
+        int fitAt(std::size_t index, int width) const {
+            int x = skyline[index].x;
+            if (x + width > size) {
+                return -1;
+            }
+            
+            int y = 0;
+            int remaining = width;
+            for (std::size_t i = index; remaining > 0; ++i) {
+                y = std::max(y, skyline[i].y);
+                remaining -= skyline[i].width;
+            }
+            return y;
+        }
+        
+        void place(std::size_t index, int x, int y, int width) {
+            Segment segment = { x, y, width };
+            skyline.insert(skyline.begin() + index, segment);
+            
+            // Trim or remove the segments now covered by the new one
+            for (std::size_t i = index + 1; i < skyline.size();) {
+                Segment& next = skyline[i];
+                int overlap = x + width - next.x;
+                if (overlap <= 0) {
+                    break;
+                }
+                if (overlap < next.width) {
+                    next.x += overlap;
+                    next.width -= overlap;
+                    break;
+                }
+                skyline.erase(skyline.begin() + i);
+            }
+            
+            // Merge neighbours at the same height
+            for (std::size_t i = 0; i + 1 < skyline.size();) {
+                if (skyline[i].y == skyline[i + 1].y) {
+                    skyline[i].width += skyline[i + 1].width;
+                    skyline.erase(skyline.begin() + i + 1);
+                } else {
+                    ++i;
+                }
+            }
+        }
+    
+    public:
+        int usedHeight = 0;
+        
+        explicit SkylinePage(int pageSize) : size(pageSize) {
+            Segment segment = { 0, 0, pageSize };
+            skyline.push_back(segment);
+        }
+        
+        bool insert(int width, int height, int& outX, int& outY) {
+            int bestY = size;
+            int bestWidth = size + 1;
+            std::size_t bestIndex = skyline.size();
+            
+            for (std::size_t i = 0; i < skyline.size(); ++i) {
+                int y = fitAt(i, width);
+                if (y < 0 || y + height > size) {
+                    continue;
+                }
+                if (y < bestY || (y == bestY && skyline[i].width < bestWidth)) {
+                    bestY = y;
+                    bestWidth = skyline[i].width;
+                    bestIndex = i;
+                }
+            }
+            
+            if (bestIndex == skyline.size()) {
+                return false;
+            }
+            
+            outX = skyline[bestIndex].x;
+            outY = bestY;
+            place(bestIndex, outX, bestY + height, width);
+            usedHeight = std::max(usedHeight, bestY + height);
+            return true;
+        }
+    };
+    
+    void collectTextures(const nlohmann::json& node, const std::string& key, const std::string& field,
+                         std::vector<Image>& images) {
+        if (node.is_object()) {
+            auto texture = node.find(field);
+            if (texture != node.end() && texture->is_string()) {
+                auto id = node.find("id");
+                Image image;
+                image.id = (id != node.end() && id->is_string()) ? id->get<std::string>() : key;
+                image.path = texture->get<std::string>();
+                images.push_back(image);
+            }
+            for (auto it = node.begin(); it != node.end(); ++it) {
+                collectTextures(it.value(), it.key(), field, images);
+            }
+        } else if (node.is_array()) {
+            for (const auto& element : node) {
+                collectTextures(element, key, field, images);
+            }
+        }
+    }
+    
+    Image makePlaceholder() {
+        // Magenta and black checkerboard
+        Image image;
+        image.id = MISSING_ID;
+        image.width = PLACEHOLDER_SIZE;
+        image.height = PLACEHOLDER_SIZE;
+        image.pixels.resize(PLACEHOLDER_SIZE * PLACEHOLDER_SIZE * 4);
+        for (int y = 0; y < PLACEHOLDER_SIZE; ++y) {
+            for (int x = 0; x < PLACEHOLDER_SIZE; ++x) {
+                bool magenta = ((x / 4) + (y / 4)) % 2 == 0;
+                unsigned char* pixel = &image.pixels[(y * PLACEHOLDER_SIZE + x) * 4];
+                pixel[0] = magenta ? 255 : 0;
+                pixel[1] = 0;
+                pixel[2] = magenta ? 255 : 0;
+                pixel[3] = 255;
+            }
+        }
+        return image;
+    }
+    
+    // Copies the image into the page and repeats its border pixels into the
+    // padding so filtering never samples a neighbour
+    void blit(std::vector<unsigned char>& page, int pageSize, const Image& image, int padding) {
+        for (int y = -padding; y < image.height + padding; ++y) {
+            int sourceY = std::min(std::max(y, 0), image.height - 1);
+            for (int x = -padding; x < image.width + padding; ++x) {
+                int sourceX = std::min(std::max(x, 0), image.width - 1);
+                const unsigned char* source = &image.pixels[(sourceY * image.width + sourceX) * 4];
+                unsigned char* destination = &page[((image.y + y) * pageSize + image.x + x) * 4];
+                std::memcpy(destination, source, 4);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string dataPath;
+    std::string field;
+    std::string name;
+    std::string outputDir;
+    std::string root = ".";
+    int pageSize = 2048;
+    int padding = 1;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            dataPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--field") == 0 && i + 1 < argc) {
+            field = argv[++i];
+        } else if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--root") == 0 && i + 1 < argc) {
+            root = argv[++i];
+        } else if (std::strcmp(argv[i], "--page-size") == 0 && i + 1 < argc) {
+            pageSize = std::max(64, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--padding") == 0 && i + 1 < argc) {
+            padding = std::max(0, std::atoi(argv[++i]));
+        } else {
+            dataPath.clear();
+            break;
+        }
+    }
+    
+    if (dataPath.empty() || field.empty() || name.empty() || outputDir.empty()) {
+        std::cout << "Usage: " << argv[0] << " --data <file.json> --field <name> --name <atlas> --out <dir>"
+                  << " [--root <dir>] [--page-size <px>] [--padding <px>]\n";
+        return -1;
+    }
+    
+    std::ifstream input(dataPath);
+    if (!input) {
+        std::cout << "Error: could not open " << dataPath << std::endl;
+        return -1;
+    }
+    
+    nlohmann::json data;
+    try {
+        input >> data;
+    } catch (const std::exception& e) {
+        std::cout << "Error: " << dataPath << ": " << e.what() << std::endl;
+        return -1;
+    }
+    
+    std::vector<Image> images;
+    collectTextures(data, "", field, images);
+    
+    // Load pixels; anything missing or oversized falls back to the placeholder
+    std::vector<Image> packed;
+    std::vector<std::string> missingIds;
+    packed.push_back(makePlaceholder());
+    for (Image& image : images) {
+        int channels = 0;
+        unsigned char* pixels = stbi_load((root + "/" + image.path).c_str(), &image.width, &image.height, &channels, 4);
+        if (!pixels) {
+            std::cout << "Warning: " << image.id << ": could not load " << image.path << std::endl;
+            missingIds.push_back(image.id);
+            continue;
+        }
+        
+        image.pixels.assign(pixels, pixels + image.width * image.height * 4);
+        stbi_image_free(pixels);
+        
+        if (image.width + padding * 2 > pageSize || image.height + padding * 2 > pageSize) {
+            std::cout << "Warning: " << image.id << ": " << image.width << "x" << image.height
+                      << " does not fit a " << pageSize << " page" << std::endl;
+            missingIds.push_back(image.id);
+            continue;
+        }
+        packed.push_back(std::move(image));
+    }
+    
+    // Tallest first keeps the skyline flat
+    std::stable_sort(packed.begin(), packed.end(), [](const Image& a, const Image& b) {
+        return a.height != b.height ? a.height > b.height : a.width > b.width;
+    });
+    
+    std::vector<SkylinePage> pages;
+    for (Image& image : packed) {
+        int width = image.width + padding * 2;
+        int height = image.height + padding * 2;
+        
+        for (std::size_t i = 0; i < pages.size() && image.page < 0; ++i) {
+            if (pages[i].insert(width, height, image.x, image.y)) {
+                image.page = static_cast<int>(i);
+            }
+        }
+        if (image.page < 0) {
+            pages.push_back(SkylinePage(pageSize));
+            pages.back().insert(width, height, image.x, image.y);
+            image.page = static_cast<int>(pages.size() - 1);
+        }
+        
+        image.x += padding;
+        image.y += padding;
+    }
+    
+    // Write pages cropped to their used height, then the index
+    nlohmann::json index;
+    index["pages"] = nlohmann::json::array();
+    for (std::size_t i = 0; i < pages.size(); ++i) {
+        std::vector<unsigned char> pixels(static_cast<std::size_t>(pageSize) * pageSize * 4, 0);
+        for (const Image& image : packed) {
+            if (image.page == static_cast<int>(i)) {
+                blit(pixels, pageSize, image, padding);
+            }
+        }
+        
+        std::string fileName = name + "_" + std::to_string(i) + ".png";
+        if (!stbi_write_png((outputDir + "/" + fileName).c_str(), pageSize, pages[i].usedHeight, 4, pixels.data(), pageSize * 4)) {
+            std::cout << "Error: could not write " << outputDir << "/" << fileName << std::endl;
+            return -1;
+        }
+        index["pages"].push_back(fileName);
+    }
+    
+    nlohmann::json regions = nlohmann::json::object();
+    nlohmann::json placeholder;
+    for (const Image& image : packed) {
+        nlohmann::json region = { image.page, image.x, image.y, image.width, image.height };
+        regions[image.id] = region;
+        if (image.id == MISSING_ID) {
+            placeholder = region;
+        }
+    }
+    for (const std::string& id : missingIds) {
+        regions[id] = placeholder;
+    }
+    index["regions"] = regions;
+    
+    std::string indexPath = outputDir + "/" + name + ".atlas.json";
+    std::ofstream output(indexPath);
+    if (!output) {
+        std::cout << "Error: could not write " << indexPath << std::endl;
+        return -1;
+    }
+    output << index.dump() << std::endl;
+    
+    std::cout << name << ": " << packed.size() - 1 << " textures packed into " << pages.size() << " page(s), "
+              << missingIds.size() << " missing" << std::endl;
+    return 0;
+}
@@ -0,0 +1,290 @@
+#include "battle/BattleSimulation.h"
+#include "data/GameData.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Usage: opmon_balance [--data <dir>] [--battles <per matchup>] [--threads <n>]
+//                      [--seed <n>] [--level <n>] [--max-time <seconds>]
+//                      [--party <id>,<id>,...] ...
+// Runs simulated battles with the game's BattleSimulation between every
+// ordered pair of parties (the first as team 0), and prints the win-rate
+// matrix, the damage per second of every devil fruit ability and the
+// throughput. Without --party, every character and enemy fights alone.
+//
+// Battle i of matchup m is always seeded from (seed, m, i), and results
+// are merged in chunk order, so the output does not depend on the number
+// of threads.
+namespace {
+    const std::size_t CHUNK_SIZE = 256;
+    const float TICK = 1.0f / 60.0f;
+    
+    struct Party {
+        std::string name;
+        std::vector<const Character*> members;
+    };
+    
+    struct Options {
+        std::string dataDir = "assets/data";
+        std::size_t battles = 2000;
+        unsigned threads = 0;
+        std::uint64_t seed = 1;
+        int level = 50;
+        float maxTime = 120;
+        std::vector<std::string> parties;
+    };
+    
+    struct ChunkResult {
+        std::uint32_t wins[TEAM_COUNT] = {};
+        std::uint32_t draws = 0;
+        std::uint64_t ticks = 0;
+        std::vector<std::vector<float>> dps; // By ability key, one sample per battle
+    };
+    
+    // splitmix64 finaliser
+    std::uint64_t mix(std::uint64_t value) {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+    
+    std::uint32_t battleSeed(std::uint64_t seed, std::size_t matchup, std::size_t battle) {
+        return static_cast<std::uint32_t>(mix(mix(seed ^ mix(matchup)) + battle));
+    }
+    
+    bool parseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--data") == 0 && hasValue) {
+                options.dataDir = argv[++i];
+            } else if (std::strcmp(argv[i], "--battles") == 0 && hasValue) {
+                options.battles = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+                options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+                options.seed = std::strtoull(argv[++i], nullptr, 10);
+            } else if (std::strcmp(argv[i], "--level") == 0 && hasValue) {
+                options.level = std::atoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--max-time") == 0 && hasValue) {
+                options.maxTime = static_cast<float>(std::atof(argv[++i]));
+            } else if (std::strcmp(argv[i], "--party") == 0 && hasValue) {
+                options.parties.push_back(argv[++i]);
+            } else {
+                return false;
+            }
+        }
+        return options.battles > 0;
+    }
+    
+    const Character* findCharacter(const GameData& data, const std::string& id) {
+        StringId key = StringInterner::instance().find(id);
+        const Character* character = data.characterById.find(key);
+        return character ? character : data.enemyById.find(key);
+    }
+    
+    bool buildParties(const GameData& data, const Options& options, std::vector<Party>& parties) {
+        StringInterner& ids = StringInterner::instance();
+        if (options.parties.empty()) {
+            for (const auto* group : { &data.characters.characters, &data.characters.enemies }) {
+                for (const auto& character : *group) {
+                    parties.push_back(Party{ std::string(ids.name(character.first)), { &character.second } });
+                }
+            }
+            return true;
+        }
+        
+        for (const std::string& spec : options.parties) {
+            Party party{ spec, {} };
+            std::size_t begin = 0;
+            while (begin <= spec.size()) {
+                std::size_t end = std::min(spec.find(',', begin), spec.size());
+                std::string id = spec.substr(begin, end - begin);
+                const Character* character = findCharacter(data, id);
+                if (!character) {
+                    std::cout << "Error: unknown character '" << id << "' in party " << spec << std::endl;
+                    return false;
+                }
+                party.members.push_back(character);
+                begin = end + 1;
+            }
+            parties.push_back(party);
+        }
+        return true;
+    }
+    
+    void percentiles(std::vector<float>& samples, float& p5, float& p50, float& p95) {
+        auto at = [&](double fraction) {
+            std::size_t index = static_cast<std::size_t>(fraction * (samples.size() - 1));
+            std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+            return samples[index];
+        };
+        p5 = at(0.05);
+        p50 = at(0.5);
+        p95 = at(0.95);
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cout << "Usage: " << argv[0] << " [--data <dir>] [--battles <per matchup>] [--threads <n>] [--seed <n>]"
+                  << " [--level <n>] [--max-time <seconds>] [--party <id>,<id>,...] ...\n";
+        return -1;
+    }
+    unsigned threadCount = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    
+    GameData data;
+    if (!data.loadFromJson(options.dataDir)) {
+        std::cout << "Error: could not load " << options.dataDir << std::endl;
+        return -1;
+    }
+    std::vector<Party> parties;
+    if (!buildParties(data, options, parties) || parties.empty()) {
+        return -1;
+    }
+    
+    // Every damaging ability of the data gets a key, in data order
+    std::unordered_map<const DevilFruitAbility*, std::size_t> abilityKeys;
+    std::vector<std::string> abilityNames;
+    for (const auto* group : { &data.characters.characters, &data.characters.enemies }) {
+        for (const auto& character : *group) {
+            if (!character.second.devilFruit) {
+                continue;
+            }
+            for (const DevilFruitAbility& ability : character.second.devilFruit->abilities) {
+                if (ability.baseDamage > 0) {
+                    abilityKeys.emplace(&ability, abilityNames.size());
+                    abilityNames.push_back(std::string(StringInterner::instance().name(character.first)) + ": "
+                                           + std::string(ability.name));
+                }
+            }
+        }
+    }
+    
+    std::size_t matchupCount = parties.size() * parties.size();
+    std::size_t chunksPerMatchup = (options.battles + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    std::vector<ChunkResult> chunks(matchupCount * chunksPerMatchup);
+    std::atomic<std::size_t> nextChunk(0);
+    std::uint64_t maxTicks = static_cast<std::uint64_t>(options.maxTime / TICK);
+    
+    auto worker = [&]() {
+        BattleSimulation battle;
+        for (std::size_t chunk = nextChunk++; chunk < chunks.size(); chunk = nextChunk++) {
+            std::size_t matchup = chunk / chunksPerMatchup;
+            std::size_t first = (chunk % chunksPerMatchup) * CHUNK_SIZE;
+            std::size_t last = std::min(first + CHUNK_SIZE, options.battles);
+            const Party* sides[TEAM_COUNT] = { &parties[matchup / parties.size()], &parties[matchup % parties.size()] };
+            ChunkResult& result = chunks[chunk];
+            result.dps.resize(abilityNames.size());
+            
+            for (std::size_t i = first; i < last; ++i) {
+                battle.reset(battleSeed(options.seed, matchup, i));
+                for (std::size_t team = 0; team < TEAM_COUNT; ++team) {
+                    for (const Character* member : sides[team]->members) {
+                        battle.addCombatant(*member, team, options.level);
+                    }
+                }
+                while (!battle.isOver() && battle.getTickCount() < maxTicks) {
+                    battle.tick(TICK);
+                }
+                
+                int winner = battle.getWinner();
+                if (winner < 0) {
+                    ++result.draws;
+                } else {
+                    ++result.wins[winner];
+                }
+                result.ticks += battle.getTickCount();
+                
+                float seconds = std::max<std::uint64_t>(battle.getTickCount(), 1) * TICK;
+                const AbilityArrays& abilities = battle.getAbilities();
+                for (std::size_t a = 0; a < abilities.size(); ++a) {
+                    result.dps[abilityKeys.at(abilities.source[a])].push_back(abilities.damageDealt[a] / seconds);
+                }
+            }
+        }
+    };
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    // Merge in chunk order
+    std::vector<std::uint32_t> wins(matchupCount, 0);
+    std::vector<std::uint32_t> draws(matchupCount, 0);
+    std::vector<std::vector<float>> dps(abilityNames.size());
+    std::uint64_t totalTicks = 0;
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        const ChunkResult& result = chunks[chunk];
+        wins[chunk / chunksPerMatchup] += result.wins[0];
+        draws[chunk / chunksPerMatchup] += result.draws;
+        totalTicks += result.ticks;
+        for (std::size_t key = 0; key < result.dps.size(); ++key) {
+            dps[key].insert(dps[key].end(), result.dps[key].begin(), result.dps[key].end());
+        }
+    }
+    
+    std::size_t nameWidth = 6;
+    for (const Party& party : parties) {
+        nameWidth = std::max(nameWidth, party.name.size());
+    }
+    std::printf("Win rate of the row party against the column party (%zu battles each, level %d)\n\n",
+                options.battles, options.level);
+    std::printf("%-*s", static_cast<int>(nameWidth), "");
+    for (std::size_t column = 0; column < parties.size(); ++column) {
+        std::printf(" %7.7s", parties[column].name.c_str());
+    }
+    std::printf("\n");
+    std::uint64_t totalDraws = 0;
+    for (std::size_t row = 0; row < parties.size(); ++row) {
+        std::printf("%-*s", static_cast<int>(nameWidth), parties[row].name.c_str());
+        for (std::size_t column = 0; column < parties.size(); ++column) {
+            std::size_t matchup = row * parties.size() + column;
+            std::printf(" %6.1f%%", 100.0 * wins[matchup] / options.battles);
+            totalDraws += draws[matchup];
+        }
+        std::printf("\n");
+    }
+    if (totalDraws > 0) {
+        std::printf("\n%llu battle(s) hit the %.0f s limit and count as losses for both sides\n",
+                    static_cast<unsigned long long>(totalDraws), options.maxTime);
+    }
+    
+    std::printf("\nDamage per second by ability (one sample per battle it took part in)\n\n");
+    std::printf("%-40s %9s %9s %9s %9s %9s\n", "ability", "battles", "mean", "p5", "p50", "p95");
+    for (std::size_t key = 0; key < abilityNames.size(); ++key) {
+        std::vector<float>& samples = dps[key];
+        if (samples.empty()) {
+            continue;
+        }
+        double sum = 0;
+        for (float sample : samples) {
+            sum += sample;
+        }
+        float p5, p50, p95;
+        percentiles(samples, p5, p50, p95);
+        std::printf("%-40s %9zu %9.1f %9.1f %9.1f %9.1f\n", abilityNames[key].c_str(), samples.size(),
+                    sum / samples.size(), p5, p50, p95);
+    }
+    
+    double battleCount = static_cast<double>(matchupCount * options.battles);
+    std::printf("\n%.0f battles, %llu ticks in %.2f s on %u thread(s): %.0f simulations/s, %.1f M ticks/s\n",
+                battleCount, static_cast<unsigned long long>(totalTicks), seconds, threadCount,
+                battleCount / seconds, totalTicks / seconds / 1e6);
+    return 0;
+}
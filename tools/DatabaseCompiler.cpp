@@ -0,0 +1,232 @@
+#include "data/DatabaseFormat.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Usage: opmon_dbc --out <game.db> <root>=<file.json> [<root>=<file.json> ...]
+// Compiles JSON data files into the flat binary format described in
+// data/DatabaseFormat.h. Each input becomes a named root of the database.
+namespace {
+    class DatabaseWriter {
+    private:
+        std::vector<std::uint8_t> body;
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, std::uint32_t> stringIndices;
+        std::vector<std::pair<std::uint32_t, nlohmann::json>> roots;
+        
+        static void putU32(std::vector<std::uint8_t>& out, std::size_t position, std::uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                out[position + i] = static_cast<std::uint8_t>(value >> (i * 8));
+            }
+        }
+        
+        static void appendU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            out.resize(out.size() + 4);
+            putU32(out, out.size() - 4, value);
+        }
+        
+        static void align(std::vector<std::uint8_t>& out, std::size_t alignment) {
+            while ((out.size() + DatabaseFormat::HEADER_SIZE) % alignment != 0) {
+                out.push_back(0);
+            }
+        }
+        
+        std::uint32_t fileOffset(std::size_t bodyPosition) const {
+            return static_cast<std::uint32_t>(DatabaseFormat::HEADER_SIZE + bodyPosition);
+        }
+        
+        std::uint32_t intern(const std::string& text) {
+            auto it = stringIndices.find(text);
+            if (it != stringIndices.end()) {
+                return it->second;
+            }
+            std::uint32_t index = static_cast<std::uint32_t>(strings.size());
+            strings.push_back(text);
+            stringIndices[text] = index;
+            return index;
+        }
+        
+        std::uint32_t appendU64(std::uint64_t value) {
+            align(body, 8);
+            std::uint32_t offset = fileOffset(body.size());
+            appendU32(body, static_cast<std::uint32_t>(value));
+            appendU32(body, static_cast<std::uint32_t>(value >> 32));
+            return offset;
+        }
+        
+        std::pair<std::uint32_t, std::uint32_t> encodeDouble(double number) {
+            std::uint64_t bits;
+            std::memcpy(&bits, &number, sizeof(bits));
+            return { DatabaseFormat::TYPE_DOUBLE, appendU64(bits) };
+        }
+        
+        // Encodes value and returns its {type, data} slot; containers are
+        // written to the body before their parent
+        std::pair<std::uint32_t, std::uint32_t> encode(const nlohmann::json& value) {
+            switch (value.type()) {
+                case nlohmann::json::value_t::boolean:
+                    return { DatabaseFormat::TYPE_BOOL, value.get<bool>() ? 1u : 0u };
+                case nlohmann::json::value_t::number_unsigned:
+                    // Past int64 the value becomes a double, as JsonTape does
+                    if (value.get<std::uint64_t>() > static_cast<std::uint64_t>(INT64_MAX)) {
+                        return encodeDouble(static_cast<double>(value.get<std::uint64_t>()));
+                    }
+                    [[fallthrough]];
+                case nlohmann::json::value_t::number_integer: {
+                    std::int64_t number = value.get<std::int64_t>();
+                    if (number >= INT32_MIN && number <= INT32_MAX) {
+                        return { DatabaseFormat::TYPE_INT, static_cast<std::uint32_t>(static_cast<std::int32_t>(number)) };
+                    }
+                    return { DatabaseFormat::TYPE_INT64, appendU64(static_cast<std::uint64_t>(number)) };
+                }
+                case nlohmann::json::value_t::number_float:
+                    return encodeDouble(value.get<double>());
+                case nlohmann::json::value_t::string:
+                    return { DatabaseFormat::TYPE_STRING, intern(value.get<std::string>()) };
+                case nlohmann::json::value_t::array: {
+                    std::vector<std::pair<std::uint32_t, std::uint32_t>> slots;
+                    for (const auto& element : value) {
+                        slots.push_back(encode(element));
+                    }
+                    
+                    align(body, 4);
+                    std::uint32_t offset = fileOffset(body.size());
+                    appendU32(body, static_cast<std::uint32_t>(slots.size()));
+                    for (const auto& slot : slots) {
+                        appendU32(body, slot.first);
+                        appendU32(body, slot.second);
+                    }
+                    return { DatabaseFormat::TYPE_ARRAY, offset };
+                }
+                case nlohmann::json::value_t::object: {
+                    std::vector<std::pair<std::string, std::pair<std::uint32_t, std::uint32_t>>> members;
+                    for (auto it = value.begin(); it != value.end(); ++it) {
+                        members.emplace_back(it.key(), encode(it.value()));
+                    }
+                    std::sort(members.begin(), members.end(), [](const auto& a, const auto& b) {
+                        return a.first < b.first;
+                    });
+                    
+                    align(body, 4);
+                    std::uint32_t offset = fileOffset(body.size());
+                    appendU32(body, static_cast<std::uint32_t>(members.size()));
+                    for (const auto& member : members) {
+                        appendU32(body, intern(member.first));
+                        appendU32(body, member.second.first);
+                        appendU32(body, member.second.second);
+                    }
+                    return { DatabaseFormat::TYPE_OBJECT, offset };
+                }
+                default:
+                    return { DatabaseFormat::TYPE_NULL, 0 };
+            }
+        }
+    
+    public:
+        void addRoot(const std::string& name, const nlohmann::json& value) {
+            roots.emplace_back(intern(name), value);
+        }
+        
+        std::vector<std::uint8_t> build() {
+            std::vector<std::pair<std::uint32_t, std::pair<std::uint32_t, std::uint32_t>>> rootSlots;
+            for (const auto& root : roots) {
+                rootSlots.emplace_back(root.first, encode(root.second));
+            }
+            
+            // String table and data follow the body
+            align(body, 4);
+            std::uint32_t stringTable = fileOffset(body.size());
+            std::uint32_t dataPosition = 0;
+            for (const std::string& text : strings) {
+                appendU32(body, dataPosition);
+                appendU32(body, static_cast<std::uint32_t>(text.size()));
+                dataPosition += static_cast<std::uint32_t>(text.size()) + 1;
+            }
+            
+            std::uint32_t stringData = fileOffset(body.size());
+            for (const std::string& text : strings) {
+                body.insert(body.end(), text.begin(), text.end());
+                body.push_back(0);
+            }
+            
+            align(body, 4);
+            std::uint32_t rootTable = fileOffset(body.size());
+            for (const auto& root : rootSlots) {
+                appendU32(body, root.first);
+                appendU32(body, root.second.first);
+                appendU32(body, root.second.second);
+            }
+            
+            std::vector<std::uint8_t> file(DatabaseFormat::HEADER_SIZE, 0);
+            std::memcpy(file.data(), DatabaseFormat::MAGIC, sizeof(DatabaseFormat::MAGIC));
+            putU32(file, DatabaseFormat::HEADER_VERSION, DatabaseFormat::VERSION);
+            putU32(file, DatabaseFormat::HEADER_FILE_SIZE, static_cast<std::uint32_t>(DatabaseFormat::HEADER_SIZE + body.size()));
+            putU32(file, DatabaseFormat::HEADER_ROOT_COUNT, static_cast<std::uint32_t>(rootSlots.size()));
+            putU32(file, DatabaseFormat::HEADER_ROOT_TABLE, rootTable);
+            putU32(file, DatabaseFormat::HEADER_STRING_COUNT, static_cast<std::uint32_t>(strings.size()));
+            putU32(file, DatabaseFormat::HEADER_STRING_TABLE, stringTable);
+            putU32(file, DatabaseFormat::HEADER_STRING_DATA, stringData);
+            file.insert(file.end(), body.begin(), body.end());
+            return file;
+        }
+        
+        std::size_t getStringCount() const { return strings.size(); }
+    };
+}
+
+int main(int argc, char** argv) {
+    std::string outputPath;
+    std::vector<std::pair<std::string, std::string>> inputs;
+    
+    for (int i = 1; i < argc; ++i) {
+        const char* separator = std::strchr(argv[i], '=');
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (separator && separator != argv[i]) {
+            inputs.emplace_back(std::string(argv[i], separator - argv[i]), std::string(separator + 1));
+        } else {
+            outputPath.clear();
+            break;
+        }
+    }
+    
+    if (outputPath.empty() || inputs.empty()) {
+        std::cout << "Usage: " << argv[0] << " --out <game.db> <root>=<file.json> [<root>=<file.json> ...]\n";
+        return -1;
+    }
+    
+    DatabaseWriter writer;
+    for (const auto& input : inputs) {
+        std::ifstream file(input.second);
+        if (!file) {
+            std::cout << "Error: could not open " << input.second << std::endl;
+            return -1;
+        }
+        
+        try {
+            nlohmann::json data;
+            file >> data;
+            writer.addRoot(input.first, data);
+        } catch (const std::exception& e) {
+            std::cout << "Error: " << input.second << ": " << e.what() << std::endl;
+            return -1;
+        }
+    }
+    
+    std::vector<std::uint8_t> database = writer.build();
+    std::ofstream output(outputPath, std::ios::binary);
+    if (!output.write(reinterpret_cast<const char*>(database.data()), database.size())) {
+        std::cout << "Error: could not write " << outputPath << std::endl;
+        return -1;
+    }
+    
+    std::cout << outputPath << ": " << inputs.size() << " roots, " << writer.getStringCount() << " strings, "
+              << database.size() << " bytes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,264 @@
+#include "data/IdHash.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Usage: opmon_idgen --out <dir> <file.json> [<file.json> ...]
+// Collects every identifier in the data files (map keys such as character
+// and item ids, and the values of reference fields such as connectedLocations
+// or next) and builds a minimal perfect hash over them with the
+// hash-and-displace method. Writes ShippedIds.h, with one ID_ constant per
+// identifier, and ShippedIdTable.h, the lookup tables for StringInterner.
+namespace {
+    // Fields whose string values (or string array elements) are identifiers
+    const char* ID_FIELDS[] = {
+        "id", "type", "region", "joinLocation", "recruitmentMethod", "target", "requiredQuest", "questRequired",
+        "next", "flag", "action", "emotion", "quest", "item", "equipSlot", "connectedLocations", "inventory", "items",
+        "enemyGroups", "weatherTypes", "specialEffects", "specialAbility", "flag_checks", "stat_checks",
+        "location_checks", "time_checks"
+    };
+    
+    // Objects keyed by identifier, and how many levels of keys are identifiers
+    const std::map<std::string, int> KEYED_FIELDS = {
+        { "characters", 1 }, { "enemies", 1 }, { "locations", 1 }, { "regions", 1 }, { "item_sets", 1 },
+        { "shop_inventories", 1 }, { "statBonuses", 1 }, { "dialogue_effects", 1 }, { "items", 2 }, { "dialogues", 2 },
+        { "setBonuses", 2 }, { "conditions", 1 }
+    };
+    
+    const std::uint32_t KEYS_PER_BUCKET = 4;
+    const std::uint32_t MAX_SEED = 1u << 24;
+    
+    bool isIdField(const std::string& field) {
+        for (const char* name : ID_FIELDS) {
+            if (field == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void collect(const nlohmann::json& node, const std::string& field, int keyedDepth, std::set<std::string>& ids) {
+        if (node.is_object()) {
+            for (auto it = node.begin(); it != node.end(); ++it) {
+                if (keyedDepth > 0) {
+                    ids.insert(it.key());
+                    collect(it.value(), "", keyedDepth - 1, ids);
+                    continue;
+                }
+                
+                auto keyed = KEYED_FIELDS.find(it.key());
+                int depth = (keyed != KEYED_FIELDS.end() && it.value().is_object()) ? keyed->second : 0;
+                collect(it.value(), it.key(), depth, ids);
+            }
+        } else if (node.is_array()) {
+            for (const auto& element : node) {
+                collect(element, field, 0, ids);
+            }
+        } else if (node.is_string() && isIdField(field)) {
+            ids.insert(node.get<std::string>());
+        }
+    }
+    
+    // Only snake_case identifiers get an ID_ constant; others (such as the
+    // display names some files use as references) are still in the table
+    bool hasConstant(const std::string& id) {
+        for (char c : id) {
+            if (!std::islower(static_cast<unsigned char>(c)) && !std::isdigit(static_cast<unsigned char>(c)) && c != '_') {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    std::string constantName(const std::string& id) {
+        std::string name = "ID_";
+        for (char c : id) {
+            name += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        return name;
+    }
+    
+    // text as a double-quoted C++ string literal
+    std::string cppStringLiteral(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out + "\"";
+    }
+    
+    // Hash and displace: buckets are placed largest first, each trying
+    // seeds until all its keys land in distinct free slots
+    bool buildPerfectHash(const std::vector<std::uint64_t>& hashes, std::vector<std::uint32_t>& seeds,
+                          std::vector<std::uint32_t>& slotOfKey) {
+        std::uint32_t count = static_cast<std::uint32_t>(hashes.size());
+        std::uint32_t bucketCount = std::max(1u, (count + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET);
+        
+        std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            buckets[perfectHashBucket(hashes[i], bucketCount)].push_back(i);
+        }
+        
+        std::vector<std::uint32_t> order(bucketCount);
+        for (std::uint32_t i = 0; i < bucketCount; ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+        
+        seeds.assign(bucketCount, 0);
+        slotOfKey.assign(count, 0);
+        std::vector<bool> used(count, false);
+        std::vector<std::uint32_t> slots;
+        for (std::uint32_t bucket : order) {
+            const std::vector<std::uint32_t>& keys = buckets[bucket];
+            if (keys.empty()) {
+                continue;
+            }
+            
+            bool placed = false;
+            for (std::uint32_t seed = 0; seed < MAX_SEED && !placed; ++seed) {
+                slots.clear();
+                placed = true;
+                for (std::uint32_t key : keys) {
+                    std::uint32_t slot = perfectHashSlot(hashes[key], seed, count);
+                    if (used[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+                        placed = false;
+                        break;
+                    }
+                    slots.push_back(slot);
+                }
+                
+                if (placed) {
+                    seeds[bucket] = seed;
+                    for (std::size_t i = 0; i < keys.size(); ++i) {
+                        used[slots[i]] = true;
+                        slotOfKey[keys[i]] = slots[i];
+                    }
+                }
+            }
+            if (!placed) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string outputDir;
+    std::vector<std::string> inputs;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outputDir = argv[++i];
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    
+    if (outputDir.empty() || inputs.empty()) {
+        std::cout << "Usage: " << argv[0] << " --out <dir> <file.json> [<file.json> ...]\n";
+        return -1;
+    }
+    
+    std::set<std::string> idSet;
+    for (const std::string& input : inputs) {
+        std::ifstream file(input);
+        if (!file) {
+            std::cout << "Error: could not open " << input << std::endl;
+            return -1;
+        }
+        
+        try {
+            nlohmann::json data;
+            file >> data;
+            collect(data, "", 0, idSet);
+        } catch (const std::exception& e) {
+            std::cout << "Error: " << input << ": " << e.what() << std::endl;
+            return -1;
+        }
+    }
+    idSet.erase("");
+    
+    std::vector<std::string> ids(idSet.begin(), idSet.end());
+    std::vector<std::uint64_t> hashes;
+    std::map<std::uint64_t, std::string> byHash;
+    for (const std::string& id : ids) {
+        std::uint64_t hash = hashId(id);
+        if (!byHash.emplace(hash, id).second) {
+            std::cout << "Error: " << id << " and " << byHash[hash] << " have the same hash" << std::endl;
+            return -1;
+        }
+        hashes.push_back(hash);
+    }
+    
+    std::vector<std::uint32_t> seeds;
+    std::vector<std::uint32_t> slotOfKey;
+    if (!buildPerfectHash(hashes, seeds, slotOfKey)) {
+        std::cout << "Error: no perfect hash found for " << ids.size() << " identifiers" << std::endl;
+        return -1;
+    }
+    
+    // An identifier's id is its slot, so a lookup needs no second table
+    std::vector<std::size_t> keyOfSlot(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        keyOfSlot[slotOfKey[i]] = i;
+    }
+    
+    const char* banner = "// Generated by opmon_idgen from assets/data. Do not edit; build the update_ids target instead.\n";
+    
+    std::ofstream constants(outputDir + "/ShippedIds.h");
+    constants << "#pragma once\n" << banner << "#include \"StringId.h\"\n#include <cstdint>\n\n";
+    constants << "const std::uint32_t SHIPPED_ID_COUNT = " << ids.size() << ";\n\n";
+    std::size_t withoutConstant = 0;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (hasConstant(ids[i])) {
+            constants << "constexpr StringId " << constantName(ids[i]) << "(" << slotOfKey[i] << ");\n";
+        } else {
+            ++withoutConstant;
+        }
+    }
+    
+    std::ofstream table(outputDir + "/ShippedIdTable.h");
+    table << "#pragma once\n" << banner << "#include \"ShippedIds.h\"\n#include <cstdint>\n\n";
+    table << "namespace {\n";
+    table << "    const std::uint32_t SHIPPED_BUCKET_COUNT = " << seeds.size() << ";\n    \n";
+    table << "    const std::uint32_t SHIPPED_BUCKET_SEEDS[SHIPPED_BUCKET_COUNT] = {";
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        table << (i % 12 == 0 ? "\n        " : " ") << seeds[i] << (i + 1 < seeds.size() ? "," : "");
+    }
+    table << "\n    };\n    \n";
+    table << "    // Full hash of the identifier in each slot, compared instead of the string\n";
+    table << "    const std::uint64_t SHIPPED_SLOT_HASHES[SHIPPED_ID_COUNT] = {";
+    for (std::size_t slot = 0; slot < ids.size(); ++slot) {
+        table << (slot % 4 == 0 ? "\n        " : " ") << "0x" << std::hex << hashes[keyOfSlot[slot]] << std::dec << "ull"
+              << (slot + 1 < ids.size() ? "," : "");
+    }
+    table << "\n    };\n    \n";
+    table << "    const char* const SHIPPED_ID_NAMES[SHIPPED_ID_COUNT] = {";
+    for (std::size_t slot = 0; slot < ids.size(); ++slot) {
+        table << "\n        " << cppStringLiteral(ids[keyOfSlot[slot]]) << (slot + 1 < ids.size() ? "," : "");
+    }
+    table << "\n    };\n}\n";
+    
+    if (!constants || !table) {
+        std::cout << "Error: could not write to " << outputDir << std::endl;
+        return -1;
+    }
+    
+    std::cout << "opmon_idgen: " << ids.size() << " identifiers (" << withoutConstant << " without a constant), "
+              << seeds.size() << " buckets" << std::endl;
+    return 0;
+}